@@ -5,26 +5,107 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <functional>
 #include <limits>
-#include <unordered_set>
+#include <mutex>
+#include <thread>
+
+// Small persistent pool for the per-tile passes: run(n, job) calls job(0..n-1)
+// across the workers and the calling thread, and returns when all are done.
+class blobWorkerPool {
+public:
+    ~blobWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(auto &worker : workers) worker.join();
+    }
+
+    void run(int count, const std::function<void(int)> &job) {
+        if(count <= 1) {
+            if(count == 1) job(0);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while(static_cast<int>(workers.size()) < count - 1) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+        currentJob = &job;
+        jobCount = count;
+        nextIndex = 0;
+        pending = count;
+        generation++;
+        wake.notify_all();
+
+        work(lock);
+        done.wait(lock, [this]() { return pending == 0; });
+        currentJob = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int)> *currentJob = nullptr;
+    int jobCount = 0;
+    int nextIndex = 0;
+    int pending = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+
+    // Called with the lock held; tiles are few, so handing them out under it is cheap
+    void work(std::unique_lock<std::mutex> &lock) {
+        while(nextIndex < jobCount) {
+            const int index = nextIndex++;
+            const auto *job = currentJob;
+            lock.unlock();
+            (*job)(index);
+            lock.lock();
+            if(--pending == 0) done.notify_all();
+        }
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        uint64_t seen = generation;
+        while(true) {
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if(stopping) return;
+            seen = generation;
+            work(lock);
+        }
+    }
+};
 
 class blobDetector : public ofxOceanodeNodeModel {
 public:
     blobDetector() : ofxOceanodeNodeModel("blobDetector") {}
 
     void setup() override {
-        description = "Thresholds a texture, detects blobs, sorts them by area, and outputs normalized blob metrics plus debug textures.";
+        description = "Thresholds a texture, detects blobs, tracks them across frames, and outputs normalized blob metrics, persistent IDs plus debug textures. Order sorts outputs by area or by ID.";
 
         addParameter(textureIn.set("Texture In", nullptr));
         addParameter(threshold.set("Threshold", 0.5f, 0.0f, 1.0f));
         addParameter(minArea.set("Min Area", 0.001f, 0.0f, 1.0f));
         addParameter(blobOutIdx.set("Blob Out Idx", {0}, {0}, {INT_MAX}));
+        addParameterDropdown(order, "Order", 0, {"Area", "ID"});
+        addParameter(trackDistance.set("Track Distance", 0.05f, 0.0f, 1.0f));
+        addParameter(trackHold.set("Track Hold", 5, 0, 600));
 
         addOutputParameter(bboxCtdX.set("bbox_ctd_x", {0.0f}, {0.0f}, {1.0f}));
         addOutputParameter(bboxCtdY.set("bbox_ctd_y", {0.0f}, {0.0f}, {1.0f}));
         addOutputParameter(areas.set("areas", {0.0f}, {0.0f}, {1.0f}));
         addOutputParameter(bboxHeight.set("bbox_height", {0.0f}, {0.0f}, {1.0f}));
         addOutputParameter(bboxWidth.set("bbox_width", {0.0f}, {0.0f}, {1.0f}));
+        addOutputParameter(ids.set("ids", {0.0f}, {0.0f}, {FLT_MAX}));
+        addOutputParameter(ages.set("ages", {0.0f}, {0.0f}, {FLT_MAX}));
+        addOutputParameter(velX.set("vel_x", {0.0f}, {-FLT_MAX}, {FLT_MAX}));
+        addOutputParameter(velY.set("vel_y", {0.0f}, {-FLT_MAX}, {FLT_MAX}));
 
         addOutputParameter(binOut.set("binOut", nullptr));
         addOutputParameter(blobOut.set("blobOut", nullptr));
@@ -48,12 +129,20 @@ public:
             return;
         }
 
-        buildBinaryMask(width, height);
-        detectBlobs(width, height);
+        // Debug images are only built for outputs somebody reads. bboxDisplay
+        // draws on top of the binary texture, so it needs that one too.
+        const bool blobOutConnected = getOceanodeParameter(blobOut).hasOutConnections();
+        const bool bboxConnected = getOceanodeParameter(bboxDisplay).hasOutConnections();
+        const bool binaryNeeded = bboxConnected || getOceanodeParameter(binOut).hasOutConnections();
+
+        planTiles(height);
+        buildBinaryMask(width, height, binaryNeeded);
+        detectBlobs(width, height, blobOutConnected);
+        trackBlobs(width, height);
         updateNumericOutputs(width, height);
-        updateBinaryTexture(width, height);
-        updateBlobTexture(width, height);
-        updateBboxDisplay(width, height);
+        if(binaryNeeded) updateBinaryTexture(width, height);
+        if(blobOutConnected) updateBlobTexture(width, height);
+        if(bboxConnected) updateBboxDisplay(width, height);
 
         binOut = &binTexture;
         blobOut = &blobTexture;
@@ -65,9 +154,15 @@ public:
         sourcePixels.clear();
         binaryMask.clear();
         labels.clear();
+        parents.clear();
+        tiles.clear();
+        labelBlobs.clear();
+        componentBlobs.clear();
         binPixels.clear();
         blobPixels.clear();
         recognizedBlobs.clear();
+        tracks.clear();
+        nextTrackId = 0;
         binTexture.clear();
         blobTexture.clear();
         bboxDisplayFbo.clear();
@@ -83,7 +178,10 @@ private:
         int maxY = 0;
         double sumX = 0.0;
         double sumY = 0.0;
-        std::vector<int> pixels;
+        int label = -1; // component id in labels, valid when they were kept
+        int trackId = -1;
+        float trackAge = 0.0f;       // seconds
+        glm::vec2 velocity = {0.0f, 0.0f}; // normalized units per second
 
         float areaNorm(int totalPixels) const {
             return totalPixels > 0 ? static_cast<float>(areaPixels) / static_cast<float>(totalPixels) : 0.0f;
@@ -118,12 +216,19 @@ private:
     ofParameter<float> threshold;
     ofParameter<float> minArea;
     ofParameter<std::vector<int>> blobOutIdx;
+    ofParameter<int> order;
+    ofParameter<float> trackDistance;
+    ofParameter<int> trackHold;
 
     ofParameter<std::vector<float>> bboxCtdX;
     ofParameter<std::vector<float>> bboxCtdY;
     ofParameter<std::vector<float>> areas;
     ofParameter<std::vector<float>> bboxHeight;
     ofParameter<std::vector<float>> bboxWidth;
+    ofParameter<std::vector<float>> ids;
+    ofParameter<std::vector<float>> ages;
+    ofParameter<std::vector<float>> velX;
+    ofParameter<std::vector<float>> velY;
     ofParameter<ofTexture*> binOut;
     ofParameter<ofTexture*> blobOut;
     ofParameter<ofTexture*> bboxDisplay;
@@ -137,15 +242,55 @@ private:
 
     std::vector<unsigned char> binaryMask;
     std::vector<int> labels;
-    std::vector<BlobData> recognizedBlobs;
+    std::vector<int> parents;
+    std::vector<BlobData> labelBlobs;     // stats per provisional label
+    std::vector<BlobData> componentBlobs; // stats per connected component
     glm::ivec2 allocatedSize = {0, 0};
 
+    // Horizontal band of rows thresholded and labeled by one worker. Labels
+    // in a tile start at 0; labelOffset makes them global after the merge.
+    struct Tile {
+        int y0 = 0;
+        int y1 = 0;
+        int labelOffset = 0;
+        std::vector<int> parents;
+    };
+    std::vector<Tile> tiles;
+    blobWorkerPool workerPool;
+
+    // A blob followed across frames: its last seen normalized centroid and
+    // how long ago that was, so the position can be predicted while missing
+    struct Track {
+        int id = 0;
+        glm::vec2 pos = {0.0f, 0.0f};
+        glm::vec2 velocity = {0.0f, 0.0f};
+        float age = 0.0f;
+        float unseen = 0.0f;
+        int missed = 0;
+    };
+    struct TrackCandidate {
+        float distance2;
+        int track;
+        int blob;
+    };
+    std::vector<Track> tracks;
+    std::vector<std::pair<int64_t, int>> blobCells;
+    std::vector<TrackCandidate> trackCandidates;
+    std::vector<int> blobTrack;
+    std::vector<unsigned char> trackMatched;
+    int nextTrackId = 0;
+    std::vector<BlobData> recognizedBlobs;
+
     void clearOutputs() {
         bboxCtdX = {};
         bboxCtdY = {};
         areas = {};
         bboxHeight = {};
         bboxWidth = {};
+        ids = {};
+        ages = {};
+        velX = {};
+        velY = {};
         binOut = nullptr;
         blobOut = nullptr;
         bboxDisplay = nullptr;
@@ -177,113 +322,151 @@ private:
         bboxDisplayFbo.end();
     }
 
-    void buildBinaryMask(int width, int height) {
+    // One tile per core, but never thinner than 64 rows so seams stay rare
+    void planTiles(int height) {
+        const int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        const int count = std::max(1, std::min(cores, height / 64));
+        tiles.resize(count);
+        for(int t = 0; t < count; t++) {
+            tiles[t].y0 = height * t / count;
+            tiles[t].y1 = height * (t + 1) / count;
+        }
+    }
+
+    void buildBinaryMask(int width, int height, bool writeDebug) {
         const int numPixels = width * height;
-        binaryMask.assign(numPixels, 0);
+        binaryMask.resize(numPixels);
 
-        const unsigned char *src = sourcePixels.getData();
-        unsigned char *dst = binPixels.getData();
         const int channels = sourcePixels.getNumChannels();
         const float threshold255 = ofClamp(threshold.get(), 0.0f, 1.0f) * 255.0f;
 
-        for(int i = 0; i < numPixels; i++) {
-            const int base = i * channels;
-
-            unsigned char r = 0;
-            unsigned char g = 0;
-            unsigned char b = 0;
-            unsigned char a = 255;
-
-            if(channels == 1) {
-                r = g = b = src[base];
-            } else if(channels == 2) {
-                r = g = b = src[base];
-                a = src[base + 1];
-            } else if(channels >= 3) {
-                r = src[base];
-                g = src[base + 1];
-                b = src[base + 2];
-                if(channels >= 4) a = src[base + 3];
+        workerPool.run(static_cast<int>(tiles.size()), [&](int t) {
+            const int begin = tiles[t].y0 * width;
+            const int count = (tiles[t].y1 - tiles[t].y0) * width;
+            const unsigned char *src = sourcePixels.getData() + static_cast<size_t>(begin) * channels;
+            unsigned char *mask = binaryMask.data() + begin;
+
+            switch(channels) {
+                case 1:  thresholdPixels<1>(src, mask, count, threshold255); break;
+                case 2:  thresholdPixels<2>(src, mask, count, threshold255); break;
+                case 3:  thresholdPixels<3>(src, mask, count, threshold255); break;
+                case 4:  thresholdPixels<4>(src, mask, count, threshold255); break;
+                default: std::fill(mask, mask + count, 0); break;
             }
 
-            const float luminance = 0.2126f * static_cast<float>(r)
-                                  + 0.7152f * static_cast<float>(g)
-                                  + 0.0722f * static_cast<float>(b);
-            const bool isWhite = a > 0 && luminance >= threshold255;
-            const unsigned char value = isWhite ? 255 : 0;
-
-            binaryMask[i] = isWhite ? 1 : 0;
+            if(writeDebug) {
+                unsigned char *dst = binPixels.getData() + static_cast<size_t>(begin) * 4;
+                for(int i = 0; i < count; i++) {
+                    const unsigned char value = mask[i] ? 255 : 0;
+                    dst[i * 4 + 0] = value;
+                    dst[i * 4 + 1] = value;
+                    dst[i * 4 + 2] = value;
+                    dst[i * 4 + 3] = 255;
+                }
+            }
+        });
+    }
 
-            const int dstBase = i * 4;
-            dst[dstBase + 0] = value;
-            dst[dstBase + 1] = value;
-            dst[dstBase + 2] = value;
-            dst[dstBase + 3] = 255;
+    // Branch-free per layout so the compiler can vectorize it; grey layouts
+    // repeat the value into r, g and b to keep the luminance bit-identical.
+    template<int C>
+    static void thresholdPixels(const unsigned char *src, unsigned char *mask, int count, float threshold255) {
+        for(int i = 0; i < count; i++) {
+            const unsigned char *px = src + i * C;
+            const float r = px[0];
+            const float g = C >= 3 ? px[1] : px[0];
+            const float b = C >= 3 ? px[2] : px[0];
+            const unsigned char a = C == 2 ? px[1] : (C == 4 ? px[3] : 255);
+
+            const float luminance = 0.2126f * r + 0.7152f * g + 0.0722f * b;
+            mask[i] = (a > 0) & (luminance >= threshold255);
         }
     }
 
-    void detectBlobs(int width, int height) {
+    // Two-pass 8-connected labeling. Pass 1 gives each pixel a provisional
+    // label from its already-visited neighbours (left, up-left, up, up-right)
+    // and records equivalences in a union-find forest whose roots are always
+    // the smallest label, i.e. the component's first pixel in raster order.
+    // Pass 2 accumulates the blob stats, so blobs come out in the same order
+    // the flood fill used to produce them.
+    //
+    // Both passes run per tile on the worker pool. Between them the tile
+    // forests are concatenated and joined across each seam row, which keeps
+    // the smallest-root order because every tile's labels follow the ones
+    // of the tiles above it.
+    void detectBlobs(int width, int height, bool keepLabels) {
         recognizedBlobs.clear();
 
         const int numPixels = width * height;
-        labels.assign(numPixels, -1);
-        std::vector<int> stack;
-        std::vector<int> componentPixels;
-        stack.reserve(1024);
-        componentPixels.reserve(1024);
-
-        int label = 0;
-        for(int y = 0; y < height; y++) {
+        labels.resize(numPixels);
+        const int tileCount = static_cast<int>(tiles.size());
+
+        workerPool.run(tileCount, [&](int t) { labelTile(tiles[t], width); });
+
+        int numLabels = 0;
+        for(Tile &tile : tiles) {
+            tile.labelOffset = numLabels;
+            numLabels += static_cast<int>(tile.parents.size());
+        }
+        parents.resize(numLabels);
+        for(const Tile &tile : tiles) {
+            for(size_t i = 0; i < tile.parents.size(); i++) {
+                parents[tile.labelOffset + i] = tile.parents[i] + tile.labelOffset;
+            }
+        }
+
+        for(int t = 1; t < tileCount; t++) {
+            const int y = tiles[t].y0;
+            const int *row = labels.data() + y * width;
+            const int *up = row - width;
+            const int offset = tiles[t].labelOffset;
+            const int upOffset = tiles[t - 1].labelOffset;
             for(int x = 0; x < width; x++) {
-                const int startIndex = y * width + x;
-                if(binaryMask[startIndex] == 0 || labels[startIndex] != -1) continue;
-
-                BlobData blob;
-                blob.minX = blob.maxX = x;
-                blob.minY = blob.maxY = y;
-
-                stack.clear();
-                componentPixels.clear();
-                stack.push_back(startIndex);
-                labels[startIndex] = label;
-
-                while(!stack.empty()) {
-                    const int index = stack.back();
-                    stack.pop_back();
-                    componentPixels.push_back(index);
-
-                    const int px = index % width;
-                    const int py = index / width;
-
-                    blob.areaPixels++;
-                    blob.sumX += static_cast<double>(px) + 0.5;
-                    blob.sumY += static_cast<double>(py) + 0.5;
-                    blob.minX = std::min(blob.minX, px);
-                    blob.maxX = std::max(blob.maxX, px);
-                    blob.minY = std::min(blob.minY, py);
-                    blob.maxY = std::max(blob.maxY, py);
-
-                    for(int oy = -1; oy <= 1; oy++) {
-                        for(int ox = -1; ox <= 1; ox++) {
-                            if(ox == 0 && oy == 0) continue;
-
-                            const int nx = px + ox;
-                            const int ny = py + oy;
-                            if(nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
-
-                            const int neighborIndex = ny * width + nx;
-                            if(binaryMask[neighborIndex] == 0 || labels[neighborIndex] != -1) continue;
-
-                            labels[neighborIndex] = label;
-                            stack.push_back(neighborIndex);
-                        }
-                    }
+                if(row[x] < 0) continue;
+                for(int nx = std::max(0, x - 1); nx <= std::min(width - 1, x + 1); nx++) {
+                    if(up[nx] >= 0) unite(row[x] + offset, up[nx] + upOffset);
                 }
+            }
+        }
 
-                blob.pixels = componentPixels;
-                if(blob.areaNorm(numPixels) >= minArea.get()) recognizedBlobs.push_back(std::move(blob));
-                label++;
+        // Roots have the lowest label in their tree, so one ascending sweep
+        // flattens every path and numbers components in raster order
+        int numComponents = 0;
+        for(int i = 0; i < numLabels; i++) {
+            parents[i] = (parents[i] == i) ? numComponents++ : parents[parents[i]];
+        }
+
+        // A single tile accumulates straight into its components; several
+        // tiles share components, so they fill per-label stats that are
+        // merged afterwards instead of contending for the same entries
+        componentBlobs.assign(numComponents, BlobData());
+        if(tileCount == 1) {
+            accumulateTile(tiles[0], width, keepLabels, componentBlobs, true);
+        } else {
+            labelBlobs.assign(numLabels, BlobData());
+            workerPool.run(tileCount, [&](int t) { accumulateTile(tiles[t], width, keepLabels, labelBlobs, false); });
+        }
+
+        for(int i = 0; tileCount > 1 && i < numLabels; i++) {
+            const BlobData &part = labelBlobs[i];
+            BlobData &blob = componentBlobs[parents[i]];
+            if(blob.areaPixels == 0) {
+                blob = part;
+                continue;
             }
+            blob.areaPixels += part.areaPixels;
+            blob.sumX += part.sumX;
+            blob.sumY += part.sumY;
+            blob.minX = std::min(blob.minX, part.minX);
+            blob.maxX = std::max(blob.maxX, part.maxX);
+            blob.minY = std::min(blob.minY, part.minY);
+            blob.maxY = std::max(blob.maxY, part.maxY);
+        }
+
+        for(int component = 0; component < numComponents; component++) {
+            BlobData &blob = componentBlobs[component];
+            blob.label = component;
+            if(blob.areaNorm(numPixels) >= minArea.get()) recognizedBlobs.push_back(blob);
         }
 
         std::sort(recognizedBlobs.begin(), recognizedBlobs.end(), [](const BlobData &a, const BlobData &b) {
@@ -293,18 +476,114 @@ private:
         });
     }
 
+    // Pass 1 over one tile; its first row is treated as the image top
+    void labelTile(Tile &tile, int width) {
+        tile.parents.clear();
+        std::vector<int> &forest = tile.parents;
+
+        for(int y = tile.y0; y < tile.y1; y++) {
+            const unsigned char *maskRow = binaryMask.data() + y * width;
+            int *row = labels.data() + y * width;
+            const int *up = y > tile.y0 ? row - width : nullptr;
+
+            for(int x = 0; x < width; x++) {
+                if(maskRow[x] == 0) {
+                    row[x] = -1;
+                    continue;
+                }
+
+                const int a = (up && x > 0) ? up[x - 1] : -1;
+                const int b = up ? up[x] : -1;
+                const int c = (up && x + 1 < width) ? up[x + 1] : -1;
+                const int d = x > 0 ? row[x - 1] : -1;
+
+                int label;
+                if(b >= 0) {
+                    // a, c and d all touch b, so they are already joined to it
+                    label = b;
+                } else if(c >= 0) {
+                    label = c;
+                    if(a >= 0) unite(forest, c, a);
+                    else if(d >= 0) unite(forest, c, d);
+                } else if(a >= 0) {
+                    label = a;
+                } else if(d >= 0) {
+                    label = d;
+                } else {
+                    label = static_cast<int>(forest.size());
+                    forest.push_back(label);
+                }
+                row[x] = label;
+            }
+        }
+    }
+
+    // Pass 2 over one tile, into stats indexed by component or by provisional label
+    void accumulateTile(const Tile &tile, int width, bool keepLabels, std::vector<BlobData> &stats, bool byComponent) {
+        for(int y = tile.y0; y < tile.y1; y++) {
+            int *row = labels.data() + y * width;
+            for(int x = 0; x < width; x++) {
+                if(row[x] < 0) continue;
+
+                const int label = row[x] + tile.labelOffset;
+                const int component = parents[label];
+                if(keepLabels) row[x] = component;
+
+                BlobData &blob = stats[byComponent ? component : label];
+                if(blob.areaPixels == 0) {
+                    blob.minX = blob.maxX = x;
+                    blob.minY = blob.maxY = y;
+                }
+                blob.areaPixels++;
+                blob.sumX += static_cast<double>(x) + 0.5;
+                blob.sumY += static_cast<double>(y) + 0.5;
+                blob.minX = std::min(blob.minX, x);
+                blob.maxX = std::max(blob.maxX, x);
+                blob.maxY = y;
+            }
+        }
+    }
+
+    static int findRoot(std::vector<int> &forest, int label) {
+        while(forest[label] != label) {
+            forest[label] = forest[forest[label]];
+            label = forest[label];
+        }
+        return label;
+    }
+
+    // Links the larger root under the smaller one
+    static void unite(std::vector<int> &forest, int a, int b) {
+        a = findRoot(forest, a);
+        b = findRoot(forest, b);
+        if(a < b) forest[b] = a;
+        else if(b < a) forest[a] = b;
+    }
+
+    void unite(int a, int b) {
+        unite(parents, a, b);
+    }
+
     void updateNumericOutputs(int width, int height) {
         std::vector<float> outBboxCtdX;
         std::vector<float> outBboxCtdY;
         std::vector<float> outAreas;
         std::vector<float> outBboxHeight;
         std::vector<float> outBboxWidth;
+        std::vector<float> outIds;
+        std::vector<float> outAges;
+        std::vector<float> outVelX;
+        std::vector<float> outVelY;
 
         outBboxCtdX.reserve(recognizedBlobs.size());
         outBboxCtdY.reserve(recognizedBlobs.size());
         outAreas.reserve(recognizedBlobs.size());
         outBboxHeight.reserve(recognizedBlobs.size());
         outBboxWidth.reserve(recognizedBlobs.size());
+        outIds.reserve(recognizedBlobs.size());
+        outAges.reserve(recognizedBlobs.size());
+        outVelX.reserve(recognizedBlobs.size());
+        outVelY.reserve(recognizedBlobs.size());
 
         const int totalPixels = width * height;
         for(const BlobData &blob : recognizedBlobs) {
@@ -313,6 +592,10 @@ private:
             outAreas.push_back(blob.areaNorm(totalPixels));
             outBboxHeight.push_back(blob.bboxHeightNorm(height));
             outBboxWidth.push_back(blob.bboxWidthNorm(width));
+            outIds.push_back(static_cast<float>(blob.trackId));
+            outAges.push_back(blob.trackAge);
+            outVelX.push_back(blob.velocity.x);
+            outVelY.push_back(blob.velocity.y);
         }
 
         bboxCtdX = outBboxCtdX;
@@ -320,6 +603,112 @@ private:
         areas = outAreas;
         bboxHeight = outBboxHeight;
         bboxWidth = outBboxWidth;
+        ids = outIds;
+        ages = outAges;
+        velX = outVelX;
+        velY = outVelY;
+    }
+
+    // Greedy nearest-centroid association. Each track is predicted one frame
+    // ahead and only looks at blobs in the 3x3 grid cells (cell size = Track
+    // Distance) around the prediction, found by binary search in the sorted
+    // cell list; candidate pairs are then claimed closest first. Unmatched
+    // tracks coast on their velocity for up to Track Hold frames, so short
+    // dropouts keep their ID.
+    void trackBlobs(int width, int height) {
+        const float dt = std::max(static_cast<float>(ofGetLastFrameTime()), 1e-4f);
+        const float radius = std::max(trackDistance.get(), 1e-4f);
+        const float radius2 = radius * radius;
+        auto cellKey = [](int cx, int cy) {
+            return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy));
+        };
+        auto positionOf = [&](const BlobData &blob) {
+            const glm::vec2 c = blob.centroidPixels();
+            return glm::vec2(c.x / static_cast<float>(width), c.y / static_cast<float>(height));
+        };
+
+        blobCells.clear();
+        for(int i = 0; i < static_cast<int>(recognizedBlobs.size()); i++) {
+            const glm::vec2 p = positionOf(recognizedBlobs[i]);
+            blobCells.emplace_back(cellKey(static_cast<int>(std::floor(p.x / radius)), static_cast<int>(std::floor(p.y / radius))), i);
+        }
+        std::sort(blobCells.begin(), blobCells.end());
+
+        trackCandidates.clear();
+        for(int t = 0; t < static_cast<int>(tracks.size()); t++) {
+            const glm::vec2 predicted = tracks[t].pos + tracks[t].velocity * (tracks[t].unseen + dt);
+            const int cx = static_cast<int>(std::floor(predicted.x / radius));
+            const int cy = static_cast<int>(std::floor(predicted.y / radius));
+            for(int oy = -1; oy <= 1; oy++) {
+                for(int ox = -1; ox <= 1; ox++) {
+                    auto range = std::equal_range(blobCells.begin(), blobCells.end(), std::make_pair(cellKey(cx + ox, cy + oy), 0),
+                                                  [](const std::pair<int64_t, int> &a, const std::pair<int64_t, int> &b) { return a.first < b.first; });
+                    for(auto it = range.first; it != range.second; ++it) {
+                        const glm::vec2 d = positionOf(recognizedBlobs[it->second]) - predicted;
+                        const float distance2 = d.x * d.x + d.y * d.y;
+                        if(distance2 <= radius2) trackCandidates.push_back({distance2, t, it->second});
+                    }
+                }
+            }
+        }
+        std::sort(trackCandidates.begin(), trackCandidates.end(), [](const TrackCandidate &a, const TrackCandidate &b) {
+            if(a.distance2 != b.distance2) return a.distance2 < b.distance2;
+            if(a.track != b.track) return a.track < b.track;
+            return a.blob < b.blob;
+        });
+
+        blobTrack.assign(recognizedBlobs.size(), -1);
+        trackMatched.assign(tracks.size(), 0);
+        for(const TrackCandidate &candidate : trackCandidates) {
+            if(trackMatched[candidate.track] || blobTrack[candidate.blob] >= 0) continue;
+            trackMatched[candidate.track] = 1;
+            blobTrack[candidate.blob] = candidate.track;
+        }
+
+        for(int i = 0; i < static_cast<int>(recognizedBlobs.size()); i++) {
+            const glm::vec2 p = positionOf(recognizedBlobs[i]);
+            if(blobTrack[i] >= 0) {
+                Track &track = tracks[blobTrack[i]];
+                // Lightly smoothed so centroid jitter doesn't dominate
+                const glm::vec2 measured = (p - track.pos) / (track.unseen + dt);
+                track.velocity = track.velocity * 0.5f + measured * 0.5f;
+                track.pos = p;
+                track.age += dt;
+                track.unseen = 0.0f;
+                track.missed = 0;
+            } else {
+                Track track;
+                track.id = nextTrackId++;
+                track.pos = p;
+                blobTrack[i] = static_cast<int>(tracks.size());
+                tracks.push_back(track);
+                trackMatched.push_back(1);
+            }
+
+            const Track &track = tracks[blobTrack[i]];
+            recognizedBlobs[i].trackId = track.id;
+            recognizedBlobs[i].trackAge = track.age;
+            recognizedBlobs[i].velocity = track.velocity;
+        }
+
+        // Coast or drop the tracks that found no blob
+        int kept = 0;
+        for(int t = 0; t < static_cast<int>(tracks.size()); t++) {
+            Track &track = tracks[t];
+            if(!trackMatched[t]) {
+                if(++track.missed > trackHold) continue;
+                track.unseen += dt;
+                track.age += dt;
+            }
+            tracks[kept++] = track;
+        }
+        tracks.resize(kept);
+
+        if(order == 1) {
+            std::sort(recognizedBlobs.begin(), recognizedBlobs.end(), [](const BlobData &a, const BlobData &b) {
+                return a.trackId < b.trackId;
+            });
+        }
     }
 
     void updateBinaryTexture(int width, int height) {
@@ -333,15 +722,22 @@ private:
         blobPixels.set(0);
         unsigned char *dst = blobPixels.getData();
 
-        std::unordered_set<int> requestedIndices;
+        std::vector<unsigned char> requested(componentBlobs.size(), 0);
+        bool anyRequested = false;
         for(int index : blobOutIdx.get()) {
-            if(index >= 0 && index < static_cast<int>(recognizedBlobs.size())) requestedIndices.insert(index);
+            if(index >= 0 && index < static_cast<int>(recognizedBlobs.size())) {
+                requested[recognizedBlobs[index].label] = 1;
+                anyRequested = true;
+            }
         }
 
-        for(int index : requestedIndices) {
-            const BlobData &blob = recognizedBlobs[index];
-            for(int pixelIndex : blob.pixels) {
-                const int base = pixelIndex * 4;
+        if(anyRequested) {
+            const int numPixels = width * height;
+            for(int i = 0; i < numPixels; i++) {
+                const int component = labels[i];
+                if(component < 0 || !requested[component]) continue;
+
+                const int base = i * 4;
                 dst[base + 0] = 255;
                 dst[base + 1] = 255;
                 dst[base + 2] = 255;
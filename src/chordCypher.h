@@ -2,6 +2,7 @@
 #define CHORD_CYPHER_H
 
 #include "chordCypherAliases.h"
+#include "harmonyLibraryStore.h"
 #include "ofxOceanodeNodeModel.h"
 #include <regex>
 #include <unordered_map>
@@ -41,6 +42,15 @@ public:
 			
 			loadChordAliases();
 			loadChordDefinitions();
+			
+			// chords.txt or the alias file edited on disk
+			listeners.push(harmonyLibraryStore::get().changed.newListener([this](string &path){
+				if(!harmonyLibraryStore::samePath(path, getDefinitionsPath()) &&
+				   !harmonyLibraryStore::samePath(path, chordCypherAliases::getAliasFilePath())) return;
+				loadChordAliases();
+				loadChordDefinitions();
+				updateChord();
+			}));
 		}
 
 private:
@@ -51,18 +61,39 @@ private:
 	ofParameter<int> rootOut;
 	ofEventListeners listeners;
 	
-	std::unordered_map<string, std::vector<int>> chordDefinitions;
-	std::unordered_map<string, string> chordAliases;
+	using DefinitionMap = std::unordered_map<string, std::vector<int>>;
+	using AliasMap = std::unordered_map<string, string>;
+	
+	// Shared with the other Chord Cypher nodes through harmonyLibraryStore
+	std::shared_ptr<const DefinitionMap> chordDefinitions = std::make_shared<DefinitionMap>();
+	std::shared_ptr<const AliasMap> chordAliases = std::make_shared<AliasMap>();
+	
+	bool hasDefinition(const string &name) const { return chordDefinitions->count(name) > 0; }
+	const std::vector<int>& definition(const string &name) const {
+		static const std::vector<int> none;
+		auto it = chordDefinitions->find(name);
+		return it != chordDefinitions->end() ? it->second : none;
+	}
+	bool hasAlias(const string &name) const { return chordAliases->count(name) > 0; }
+	const string& alias(const string &name) const {
+		static const string none;
+		auto it = chordAliases->find(name);
+		return it != chordAliases->end() ? it->second : none;
+	}
 
 	void loadChordAliases() {
-		chordAliases.clear();
-		if(chordCypherAliases::mergeAliasesFromFile(chordAliases, "ChordCypher") == 0) {
-			setupChordMap();
-		}
+		chordAliases = harmonyLibraryStore::get().load<AliasMap>(chordCypherAliases::getAliasFilePath(), "chordCypherAliases",
+			[](const string &){
+				AliasMap aliases;
+				if(chordCypherAliases::mergeAliasesFromFile(aliases, "ChordCypher") == 0) {
+					aliases = defaultChordAliases();
+				}
+				return aliases;
+			});
 	}
 	
-	void setupChordMap() {
-		chordAliases = {
+	static AliasMap defaultChordAliases() {
+		return {
 				// Basic triads and qualities
 				{"major", "M"},
 				{"Major", "M"},
@@ -303,13 +334,24 @@ private:
 			};
 	}
 	
+	static string getDefinitionsPath() {
+		return ofToDataPath("Supercollider/Pitchclass/chords.txt");
+	}
+	
 	void loadChordDefinitions() {
-		string path = ofToDataPath("Supercollider/Pitchclass/chords.txt");
+		chordDefinitions = harmonyLibraryStore::get().load<DefinitionMap>(getDefinitionsPath(), "chordCypherDefinitions", parseChordDefinitions);
+		if(chordDefinitions->empty()) {
+			output.set(std::vector<int>{0});
+		}
+	}
+	
+	// Runs on the store's watcher thread on reload
+	static DefinitionMap parseChordDefinitions(const string &path) {
+		DefinitionMap chordDefinitions;
 		ofBuffer buffer = ofBufferFromFile(path);
 		if(!buffer.size()) {
 			ofLogError("ChordCypher") << "Could not load chord definitions file at path: " << path;
-			output.set(std::vector<int>{0});
-			return;
+			return chordDefinitions;
 		}
 		
 		for(auto line : buffer.getLines()) {
@@ -411,6 +453,8 @@ private:
 		if(chordDefinitions.find("M7#11") == chordDefinitions.end()) {
 			chordDefinitions["M7#11"] = {0, 4, 7, 11, 18}; // Root, M3, 5, M7, #11
 		}
+		
+		return chordDefinitions;
 	}
 	
 	void updateChord() {
@@ -475,7 +519,7 @@ private:
 			
 			// If no suffix, default to major
 			if(chordSuffix.empty()) {
-				intervals = chordDefinitions["M"];
+				intervals = definition("M");
 			} else {
 				// Try to find exact match in definitions
 				bool foundMatch = false;
@@ -484,16 +528,16 @@ private:
 				chordSuffix.erase(std::remove(chordSuffix.begin(), chordSuffix.end(), ' '), chordSuffix.end());
 				
 				// Check for exact match in definitions
-				if(chordDefinitions.find(chordSuffix) != chordDefinitions.end()) {
-					intervals = chordDefinitions[chordSuffix];
+				if(hasDefinition(chordSuffix)) {
+					intervals = definition(chordSuffix);
 					foundMatch = true;
 				}
 				
 				// Check if it's in aliases
-				if(!foundMatch && chordAliases.find(chordSuffix) != chordAliases.end()) {
-					string aliasedType = chordAliases[chordSuffix];
-					if(chordDefinitions.find(aliasedType) != chordDefinitions.end()) {
-						intervals = chordDefinitions[aliasedType];
+				if(!foundMatch && hasAlias(chordSuffix)) {
+					string aliasedType = alias(chordSuffix);
+					if(hasDefinition(aliasedType)) {
+						intervals = definition(aliasedType);
 						foundMatch = true;
 					}
 				}
@@ -554,23 +598,23 @@ private:
 					if(!prefix.empty() && !suffix.empty()) {
 						// Look for the suffix in definitions or aliases
 						string aliasedSuffix = suffix;
-						if(chordAliases.find(suffix) != chordAliases.end()) {
-							aliasedSuffix = chordAliases[suffix];
+						if(hasAlias(suffix)) {
+							aliasedSuffix = alias(suffix);
 						}
 						
 						// Try to find combined version first (e.g., "madd9")
 						string combinedType = prefix + aliasedSuffix;
-						if(chordDefinitions.find(combinedType) != chordDefinitions.end()) {
-							intervals = chordDefinitions[combinedType];
+						if(hasDefinition(combinedType)) {
+							intervals = definition(combinedType);
 							foundMatch = true;
 						}
 						// If not found, try to compose from prefix and suffix
-						else if(chordDefinitions.find(prefix) != chordDefinitions.end() &&
-								chordDefinitions.find(aliasedSuffix) != chordDefinitions.end()) {
+						else if(hasDefinition(prefix) &&
+								hasDefinition(aliasedSuffix)) {
 							// Special handling for add chords - merge intervals
 							if(aliasedSuffix == "add9" || aliasedSuffix == "add11" || aliasedSuffix == "add13") {
-								intervals = chordDefinitions[prefix]; // Start with the basic chord
-								std::vector<int> addIntervals = chordDefinitions[aliasedSuffix];
+								intervals = definition(prefix); // Start with the basic chord
+								std::vector<int> addIntervals = definition(aliasedSuffix);
 								
 								// Find the added interval (usually the last one)
 								if(!addIntervals.empty()) {
@@ -599,9 +643,9 @@ private:
 						if(addInterval > 0) {
 							// First see if the chord starts with 'm' for minor
 							if(chordSuffix.length() > 3 && (chordSuffix[0] == 'm' || chordSuffix.substr(0, 3) == "min")) {
-								intervals = chordDefinitions["m"];  // Minor triad
+								intervals = definition("m");  // Minor triad
 							} else {
-								intervals = chordDefinitions["M"];  // Major triad
+								intervals = definition("M");  // Major triad
 							}
 							intervals.push_back(addInterval);  // Add the extension
 							foundMatch = true;
@@ -613,17 +657,17 @@ private:
 				if(!foundMatch) {
 					// Try to recognize some common patterns
 					if(chordSuffix == "7" || chordSuffix == "dom7") {
-						intervals = chordDefinitions["7"];
+						intervals = definition("7");
 					} else if(chordSuffix == "9" || chordSuffix == "dom9") {
-						intervals = chordDefinitions["9"];
+						intervals = definition("9");
 					} else if(chordSuffix == "11" || chordSuffix == "dom11") {
-						intervals = chordDefinitions["11"];
+						intervals = definition("11");
 					} else if(chordSuffix == "13" || chordSuffix == "dom13") {
-						intervals = chordDefinitions["13"];
+						intervals = definition("13");
 					} else {
 						// Default to major triad if we still can't figure it out
 						ofLogWarning("ChordCypher") << "Unknown chord type: " << chordSuffix << " in chord: " << input;
-						intervals = chordDefinitions["M"];
+						intervals = definition("M");
 					}
 				}
 			}
@@ -3,6 +3,7 @@
 
 #include "ofxOceanodeNodeModel.h"
 #include "ofJson.h"
+#include "harmonyLibraryStore.h"
 
 class chordProgressions : public ofxOceanodeNodeModel {
 public:
@@ -68,6 +69,15 @@ public:
         listeners.push(remove.newListener([this](void){
             deleteProgression();
         }));
+        
+        // Saved by another node or edited on disk
+        listeners.push(harmonyLibraryStore::get().changed.newListener([this](string &path){
+            if(!harmonyLibraryStore::samePath(path, getDatabasePath())) return;
+            database = *loadSharedDatabase();
+            if(!database.contains("progressions")) database["progressions"] = ofJson::object();
+            updateProgressionList();
+            getOceanodeParameter(selectedProgression).setDropdownOptions(progressionNames);
+        }));
     }
     
 private:
@@ -87,12 +97,20 @@ private:
     std::vector<string> progressionNames;
     ofJson database;
     
+    string getDatabasePath() const {
+        return ofToDataPath("Supercollider/Pitchclass/chord_progressions.json");
+    }
+    
+    // Parsed once for all nodes; this node edits its own copy
+    std::shared_ptr<const ofJson> loadSharedDatabase() {
+        return harmonyLibraryStore::get().loadJson(getDatabasePath());
+    }
+    
     void loadProgressions() {
-        string path = ofToDataPath("Supercollider/Pitchclass/chord_progressions.json");
-        ofFile file(path);
+        auto shared = loadSharedDatabase();
         
-        if(file.exists()) {
-            database = ofLoadJson(path);
+        if(!shared->is_null()) {
+            database = *shared;
             updateProgressionList();
         } else {
             // Create empty database
@@ -102,12 +120,13 @@ private:
     }
     
     void saveDatabase() {
-        string path = ofToDataPath("Supercollider/Pitchclass/chord_progressions.json");
+        string path = getDatabasePath();
         ofFile file(path, ofFile::WriteOnly);
         if(file.is_open()) {
             string jsonStr = database.dump(4);
             file.write(jsonStr.c_str(), jsonStr.length());
             file.close();
+            harmonyLibraryStore::get().publish<ofJson>(path, "json", database);
         } else {
             ofLogError("ChordProgressions") << "Could not open file for writing at: " << path;
         }
@@ -61,6 +61,14 @@ namespace {
         float w;
     };
 
+    // Position of item inside items, or -1 when it is a copy held elsewhere
+    template<typename T>
+    int indexOfElement(const std::vector<T> &items, const T &item) {
+        std::less<const T *> before;
+        if(items.empty() || before(&item, items.data()) || !before(&item, items.data() + items.size())) return -1;
+        return static_cast<int>(&item - items.data());
+    }
+
     int wrapIndex(int value, int size) {
         if(size <= 0) return -1;
         int wrapped = value % size;
@@ -649,7 +657,6 @@ chordSequenceSnapshot chordSequenceSnapshot::fromJson(const ofJson &json) {
 
 chordSequence::chordSequence() : ofxOceanodeNodeModel("Chord Sequence") {
     description = "Builds chord and scale progressions with cypher import and per-output shaping.";
-    randomEngine.seed(std::random_device{}());
 }
 
 void chordSequence::setup() {
@@ -695,6 +702,18 @@ void chordSequence::setup() {
     listeners.push(resetSequenceParameter.newListener([this]() {
         resetInternalSequence(true);
     }));
+    listeners.push(harmonyLibraryStore::get().changed.newListener([this](std::string &path) {
+        auto isPitchClassFile = [&](const std::string &fileName) {
+            return harmonyLibraryStore::samePath(path, resolvePitchClassFile(fileName));
+        };
+        if(isPitchClassFile("chords.txt") || isPitchClassFile("scales.txt") || isPitchClassFile("functional_harmony.json") ||
+           harmonyLibraryStore::samePath(path, chordCypherAliases::getAliasFilePath())) {
+            reloadLibraries();
+        }
+        if(isPitchClassFile("JazzStandards.json") || harmonyLibraryStore::samePath(path, getChordProgressionsFilePath())) {
+            loadImportSources();
+        }
+    }));
 
     effectiveGlobalTranspose = globalTranspose;
     effectiveGlobalInvert = globalInvert;
@@ -811,44 +830,44 @@ void chordSequence::presetHasLoaded() {
 }
 
 void chordSequence::loadLibraries() {
-    chordLibrary = parsePitchClassFile(resolvePitchClassFile("chords.txt"));
-    scaleLibrary = parsePitchClassFile(resolvePitchClassFile("scales.txt"));
+    chordLibrary = harmonyLibraryStore::get().load<LibraryItems>(resolvePitchClassFile("chords.txt"), "chordSequence", parsePitchClassFile);
+    scaleLibrary = harmonyLibraryStore::get().load<LibraryItems>(resolvePitchClassFile("scales.txt"), "chordSequence", parsePitchClassFile);
     loadCypherAliases();
     loadFunctionalHarmony();
+    libraryGeneration++;
 
-    if(chordLibrary.empty()) {
-        chordLibrary.push_back({"Unavailable", {0.0f}});
-    }
-
-    if(scaleLibrary.empty()) {
-        scaleLibrary.push_back({"Unavailable", {0.0f}});
-    }
-
-    defaultChordIndex = std::max(0, findItemIndexByName(chordLibrary, "M"));
-    defaultScaleIndex = std::max(0, findItemIndexByName(scaleLibrary, "major"));
-    if(globalScaleName.empty() && globalScaleIndex == 0 && defaultScaleIndex >= 0 && defaultScaleIndex < static_cast<int>(scaleLibrary.size())) {
+    defaultChordIndex = std::max(0, findItemIndexByName(*chordLibrary, "M"));
+    defaultScaleIndex = std::max(0, findItemIndexByName(*scaleLibrary, "major"));
+    if(globalScaleName.empty() && globalScaleIndex == 0 && defaultScaleIndex >= 0 && defaultScaleIndex < static_cast<int>(scaleLibrary->size())) {
         globalScaleIndex = defaultScaleIndex;
-        globalScaleName = scaleLibrary[defaultScaleIndex].name;
+        globalScaleName = (*scaleLibrary)[defaultScaleIndex].name;
     }
     sanitizeGlobalScaleSelection();
 }
 
 void chordSequence::loadCypherAliases() {
-    chordAliases.clear();
-    chordCypherAliases::mergeAliasesFromFile(chordAliases, "chordSequence");
+    chordAliases = harmonyLibraryStore::get().load<AliasMap>(chordCypherAliases::getAliasFilePath(), "chordSequence", [](const std::string &) {
+        AliasMap aliases;
+        chordCypherAliases::mergeAliasesFromFile(aliases, "chordSequence");
+        return aliases;
+    });
 }
 
 void chordSequence::loadFunctionalHarmony() {
-    functionalHarmonyLibrary.clear();
+    functionalHarmonyLibrary = harmonyLibraryStore::get().load<FunctionalLibrary>(resolvePitchClassFile("functional_harmony.json"), "chordSequence", parseFunctionalHarmony);
+}
+
+chordSequence::FunctionalLibrary chordSequence::parseFunctionalHarmony(const std::string &path) {
+    FunctionalLibrary library;
 
-    ofFile file(resolvePitchClassFile("functional_harmony.json"));
+    ofFile file(path);
     if(!file.exists()) {
         ofLogWarning("chordSequence") << "Functional harmony file not found: " << file.getAbsolutePath();
-        return;
+        return library;
     }
 
     ofJson json = ofLoadJson(file.getAbsolutePath());
-    if(!json.is_object()) return;
+    if(!json.is_object()) return library;
 
     for(auto &[scaleName, scaleValue] : json.items()) {
         if(!scaleValue.is_object()) continue;
@@ -869,19 +888,21 @@ void chordSequence::loadFunctionalHarmony() {
             }
         }
 
-        functionalHarmonyLibrary[scaleName] = groups;
+        library[scaleName] = groups;
     }
+    return library;
 }
 
 std::string chordSequence::resolvePitchClassFile(const std::string &fileName) const {
     return ofToDataPath("Supercollider/Pitchclass/" + fileName, true);
 }
 
-std::vector<chordSequenceLibraryItem> chordSequence::parsePitchClassFile(const std::string &path) const {
-    std::vector<chordSequenceLibraryItem> result;
+chordSequence::LibraryItems chordSequence::parsePitchClassFile(const std::string &path) {
+    LibraryItems result;
     ofFile file(path);
     if(!file.exists()) {
         ofLogWarning("chordSequence") << "Pitchclass file not found: " << path;
+        result.push_back({"Unavailable", {0.0f}});
         return result;
     }
 
@@ -908,33 +929,29 @@ std::vector<chordSequenceLibraryItem> chordSequence::parsePitchClassFile(const s
         result.push_back(item);
     }
 
+    if(result.empty()) {
+        result.push_back({"Unavailable", {0.0f}});
+    }
     return result;
 }
 
 void chordSequence::loadImportSources() {
-    importedProgressionDatabase = ofJson::object();
-    importedProgressionDatabase["progressions"] = ofJson::object();
-    jazzStandardsDatabase = ofJson();
     jazzStandardNames.clear();
 
-    std::string progressionPath = getChordProgressionsFilePath();
-    ofFile progressionFile(progressionPath);
-    if(progressionFile.exists()) {
-        importedProgressionDatabase = ofLoadJson(progressionPath);
-        if(!importedProgressionDatabase.contains("progressions") || !importedProgressionDatabase["progressions"].is_object()) {
-            importedProgressionDatabase["progressions"] = ofJson::object();
-        }
+    importedProgressionSource = harmonyLibraryStore::get().loadJson(getChordProgressionsFilePath());
+    importedProgressionDatabase = *importedProgressionSource;
+    if(!importedProgressionDatabase.is_object()) {
+        importedProgressionDatabase = ofJson::object();
+    }
+    if(!importedProgressionDatabase.contains("progressions") || !importedProgressionDatabase["progressions"].is_object()) {
+        importedProgressionDatabase["progressions"] = ofJson::object();
     }
     refreshImportedProgressionNames();
 
-    std::string jazzPath = ofToDataPath("Supercollider/Pitchclass/JazzStandards.json");
-    ofFile jazzFile(jazzPath);
-    if(jazzFile.exists()) {
-        jazzStandardsDatabase = ofLoadJson(jazzPath);
-        if(jazzStandardsDatabase.is_array()) {
-            for(const auto &song : jazzStandardsDatabase) {
-                jazzStandardNames.push_back(song.value("Title", "Untitled"));
-            }
+    jazzStandardsDatabase = harmonyLibraryStore::get().loadJson(ofToDataPath("Supercollider/Pitchclass/JazzStandards.json"));
+    if(jazzStandardsDatabase->is_array()) {
+        for(const auto &song : *jazzStandardsDatabase) {
+            jazzStandardNames.push_back(song.value("Title", "Untitled"));
         }
     }
 }
@@ -1171,15 +1188,15 @@ void chordSequence::initializePublishableEditorParameters() {
                      keyOptions);
 
     std::vector<std::string> scaleOptions;
-    scaleOptions.reserve(scaleLibrary.size());
-    for(const auto &item : scaleLibrary) scaleOptions.push_back(item.name);
+    scaleOptions.reserve(scaleLibrary->size());
+    for(const auto &item : *scaleLibrary) scaleOptions.push_back(item.name);
     registerIntProxy("globalScale", "Key Scale", 0, std::max(0, static_cast<int>(scaleOptions.size()) - 1),
                      [this]() { return getGlobalScaleSafeIndex(); },
                      [this](int value) {
-                         if(scaleLibrary.empty()) return;
-                         int index = ofClamp(value, 0, static_cast<int>(scaleLibrary.size()) - 1);
+                         if(scaleLibrary->empty()) return;
+                         int index = ofClamp(value, 0, static_cast<int>(scaleLibrary->size()) - 1);
                          globalScaleIndex = index;
-                         globalScaleName = scaleLibrary[index].name;
+                         globalScaleName = (*scaleLibrary)[index].name;
                          sanitizeProgression();
                          refreshAllOutputs(true);
                      },
@@ -1798,7 +1815,7 @@ void chordSequence::initializeDefaultProgression() {
     for(auto &entry : progression) {
         entry.mode = chordSequenceEntry::Chord;
         entry.itemIndex = defaultChordIndex;
-        entry.itemName = chordLibrary[defaultChordIndex].name;
+        entry.itemName = (*chordLibrary)[defaultChordIndex].name;
         entry.functionalGroup = 0;
         entry.functionalVariantIndex = 0;
         entry.functionalVariantLabel = "I";
@@ -1818,7 +1835,7 @@ void chordSequence::resizeProgression(int newSize) {
     for(int i = oldSize; i < newSize; i++) {
         progression[i].mode = chordSequenceEntry::Chord;
         progression[i].itemIndex = defaultChordIndex;
-        progression[i].itemName = chordLibrary[defaultChordIndex].name;
+        progression[i].itemName = (*chordLibrary)[defaultChordIndex].name;
         progression[i].functionalGroup = 0;
         progression[i].functionalVariantIndex = 0;
         progression[i].functionalVariantLabel = "I";
@@ -1934,24 +1951,24 @@ void chordSequence::sanitizeMarkovRows() {
 }
 
 void chordSequence::sanitizeGlobalScaleSelection() {
-    if(scaleLibrary.empty()) {
+    if(scaleLibrary->empty()) {
         globalScaleIndex = 0;
         globalScaleName.clear();
         return;
     }
 
-    if(globalScaleName.empty() && globalScaleIndex == 0 && defaultScaleIndex >= 0 && defaultScaleIndex < static_cast<int>(scaleLibrary.size())) {
+    if(globalScaleName.empty() && globalScaleIndex == 0 && defaultScaleIndex >= 0 && defaultScaleIndex < static_cast<int>(scaleLibrary->size())) {
         globalScaleIndex = defaultScaleIndex;
     }
 
-    int nameIndex = findItemIndexByName(scaleLibrary, globalScaleName);
+    int nameIndex = findItemIndexByName(*scaleLibrary, globalScaleName);
     if(nameIndex >= 0) {
         globalScaleIndex = nameIndex;
     } else {
-        globalScaleIndex = ofClamp(globalScaleIndex, 0, static_cast<int>(scaleLibrary.size()) - 1);
+        globalScaleIndex = ofClamp(globalScaleIndex, 0, static_cast<int>(scaleLibrary->size()) - 1);
     }
 
-    globalScaleName = scaleLibrary[globalScaleIndex].name;
+    globalScaleName = (*scaleLibrary)[globalScaleIndex].name;
 }
 
 bool chordSequence::parseChordTokenToEntry(const std::string &token, chordSequenceEntry &entry) const {
@@ -2008,12 +2025,12 @@ std::string chordSequence::normalizeChordQuality(const std::string &quality) con
     q.erase(std::remove(q.begin(), q.end(), ' '), q.end());
     if(q.empty()) return "M";
 
-    for(const auto &item : chordLibrary) {
+    for(const auto &item : *chordLibrary) {
         if(item.name == q) return item.name;
     }
 
-    std::string resolved = chordCypherAliases::resolveAlias(chordAliases, q);
-    for(const auto &item : chordLibrary) {
+    std::string resolved = chordCypherAliases::resolveAlias(*chordAliases, q);
+    for(const auto &item : *chordLibrary) {
         if(item.name == resolved) return item.name;
     }
 
@@ -2051,10 +2068,10 @@ std::vector<std::string> chordSequence::parseChordSequenceString(const std::stri
 
 std::vector<std::string> chordSequence::extractJazzStandardChords(int songIndex) const {
     std::vector<std::string> result;
-    if(!jazzStandardsDatabase.is_array()) return result;
-    if(songIndex < 0 || songIndex >= static_cast<int>(jazzStandardsDatabase.size())) return result;
+    if(!jazzStandardsDatabase->is_array()) return result;
+    if(songIndex < 0 || songIndex >= static_cast<int>(jazzStandardsDatabase->size())) return result;
 
-    const auto &song = jazzStandardsDatabase[songIndex];
+    const auto &song = (*jazzStandardsDatabase)[songIndex];
     if(!song.contains("Sections") || !song["Sections"].is_array()) return result;
 
     for(const auto &section : song["Sections"]) {
@@ -2148,6 +2165,7 @@ bool chordSequence::appendImportedProgression(const std::string &name, const std
     };
 
     ofSavePrettyJson(getChordProgressionsFilePath(), importedProgressionDatabase);
+    harmonyLibraryStore::get().publish<ofJson>(getChordProgressionsFilePath(), "json", importedProgressionDatabase);
     refreshImportedProgressionNames();
     selectedImportedProgression = std::max(0, static_cast<int>(importedProgressionNames.size()) - 1);
     return true;
@@ -2184,12 +2202,12 @@ std::string chordSequence::getItemLabel(const chordSequenceEntry &entry) const {
 }
 
 const std::vector<chordSequenceLibraryItem> &chordSequence::getLibraryForMode(int mode) const {
-    return mode == chordSequenceEntry::Scale ? scaleLibrary : chordLibrary;
+    return mode == chordSequenceEntry::Scale ? *scaleLibrary : *chordLibrary;
 }
 
 int chordSequence::getGlobalScaleSafeIndex() const {
-    if(scaleLibrary.empty()) return -1;
-    return ofClamp(globalScaleIndex, 0, static_cast<int>(scaleLibrary.size()) - 1);
+    if(scaleLibrary->empty()) return -1;
+    return ofClamp(globalScaleIndex, 0, static_cast<int>(scaleLibrary->size()) - 1);
 }
 
 int chordSequence::getResolvedEntryDegree(const chordSequenceEntry &entry) const {
@@ -2205,10 +2223,10 @@ int chordSequence::getResolvedEntryDegree(const chordSequenceEntry &entry) const
 
 const std::array<std::vector<chordSequenceFunctionalVariant>, 3> *chordSequence::getCurrentFunctionalGroups() const {
     int safeScaleIndex = getGlobalScaleSafeIndex();
-    if(safeScaleIndex < 0 || safeScaleIndex >= static_cast<int>(scaleLibrary.size())) return nullptr;
+    if(safeScaleIndex < 0 || safeScaleIndex >= static_cast<int>(scaleLibrary->size())) return nullptr;
 
-    auto it = functionalHarmonyLibrary.find(scaleLibrary[safeScaleIndex].name);
-    if(it == functionalHarmonyLibrary.end()) return nullptr;
+    auto it = functionalHarmonyLibrary->find((*scaleLibrary)[safeScaleIndex].name);
+    if(it == functionalHarmonyLibrary->end()) return nullptr;
     return &it->second;
 }
 
@@ -2256,7 +2274,7 @@ std::vector<float> chordSequence::buildDegreeValues(const chordSequenceEntry &en
     int safeScaleIndex = getGlobalScaleSafeIndex();
     if(safeScaleIndex < 0) return {0.0f};
 
-    const std::vector<float> &scaleValues = scaleLibrary[safeScaleIndex].values;
+    const std::vector<float> &scaleValues = (*scaleLibrary)[safeScaleIndex].values;
     if(scaleValues.empty()) return {0.0f};
 
     int scaleSize = static_cast<int>(scaleValues.size());
@@ -2283,9 +2301,9 @@ std::vector<float> chordSequence::buildEntryIntervals(const chordSequenceEntry &
         std::string quality;
         parseCypherRootAndQuality(entry.itemName, rootValue, quality);
 
-        int qualityIndex = findItemIndexByName(chordLibrary, quality);
+        int qualityIndex = findItemIndexByName(*chordLibrary, quality);
         if(qualityIndex < 0) qualityIndex = defaultChordIndex;
-        return chordLibrary[qualityIndex].values;
+        return (*chordLibrary)[qualityIndex].values;
     }
 
     if(entry.mode == chordSequenceEntry::Degree || entry.mode == chordSequenceEntry::Functional) {
@@ -2299,7 +2317,11 @@ std::vector<float> chordSequence::buildEntryIntervals(const chordSequenceEntry &
     return library[safeIndex].values;
 }
 
-std::vector<float> chordSequence::getDiatonicReferenceScale(const chordSequenceEntry &entry) const {
+const std::vector<float> &chordSequence::getDiatonicReferenceScale(const chordSequenceEntry &entry) const {
+    return getEntryCache(entry).diatonicReference;
+}
+
+std::vector<float> chordSequence::computeDiatonicReferenceScale(const chordSequenceEntry &entry) const {
     if(entry.mode == chordSequenceEntry::Scale) {
         const auto &library = getLibraryForMode(entry.mode);
         if(library.empty()) return {};
@@ -2314,9 +2336,9 @@ std::vector<float> chordSequence::getDiatonicReferenceScale(const chordSequenceE
 
     if(entry.mode == chordSequenceEntry::Degree || entry.mode == chordSequenceEntry::Functional) {
         int safeScaleIndex = getGlobalScaleSafeIndex();
-        if(safeScaleIndex < 0 || safeScaleIndex >= static_cast<int>(scaleLibrary.size())) return {};
+        if(safeScaleIndex < 0 || safeScaleIndex >= static_cast<int>(scaleLibrary->size())) return {};
 
-        std::vector<float> reference = scaleLibrary[safeScaleIndex].values;
+        std::vector<float> reference = (*scaleLibrary)[safeScaleIndex].values;
         for(auto &value : reference) {
             value += static_cast<float>(globalKey + entry.transpose);
         }
@@ -2335,7 +2357,7 @@ std::vector<float> chordSequence::applyDiatonicDeviation(const std::vector<float
         return values;
     }
 
-    std::vector<float> reference = getDiatonicReferenceScale(entry);
+    const std::vector<float> &reference = getDiatonicReferenceScale(entry);
     if(reference.empty()) return values;
 
     int scaleSize = static_cast<int>(reference.size());
@@ -2343,7 +2365,7 @@ std::vector<float> chordSequence::applyDiatonicDeviation(const std::vector<float
 
     std::vector<float> deviated = values;
     for(auto &value : deviated) {
-        if(ofRandom(100.0f) >= entry.diatonicDeviationProbability) continue;
+        if(randomEngine.uniform(100.0f) >= entry.diatonicDeviationProbability) continue;
 
         int centerOctave = static_cast<int>(std::floor(value / 12.0f));
         int closestScalarIndex = 0;
@@ -2362,7 +2384,7 @@ std::vector<float> chordSequence::applyDiatonicDeviation(const std::vector<float
 
         int deviation = 0;
         while(deviation == 0) {
-            deviation = static_cast<int>(std::floor(ofRandom(static_cast<float>(entry.diatonicDeviationRange * 2 + 1)))) -
+            deviation = static_cast<int>(std::floor(randomEngine.uniform(static_cast<float>(entry.diatonicDeviationRange * 2 + 1)))) -
                         entry.diatonicDeviationRange;
         }
 
@@ -2383,11 +2405,11 @@ std::vector<float> chordSequence::applyChromaticDeviation(const std::vector<floa
 
     std::vector<float> deviated = values;
     for(auto &value : deviated) {
-        if(ofRandom(100.0f) >= probability) continue;
+        if(randomEngine.uniform(100.0f) >= probability) continue;
 
         int deviation = 0;
         while(deviation == 0) {
-            deviation = static_cast<int>(std::floor(ofRandom(static_cast<float>(range * 2 + 1)))) - range;
+            deviation = static_cast<int>(std::floor(randomEngine.uniform(static_cast<float>(range * 2 + 1)))) - range;
         }
         value += static_cast<float>(deviation);
     }
@@ -2398,7 +2420,7 @@ std::vector<float> chordSequence::applyChromaticDeviation(const std::vector<floa
 std::vector<float> chordSequence::buildChordSumValues() const {
     std::set<int> distinctPitchClasses;
     for(const auto &progressionEntry : progression) {
-        std::vector<float> entryValues = buildEntryPreviewOutput(progressionEntry);
+        const std::vector<float> &entryValues = buildEntryPreviewOutput(progressionEntry);
         for(float value : entryValues) {
             int pitchClass = wrapIndex(static_cast<int>(std::round(value)), 12);
             if(pitchClass >= 0) distinctPitchClasses.insert(pitchClass);
@@ -2423,8 +2445,8 @@ std::vector<float> chordSequence::buildOutputSourceValues(const chordSequenceEnt
     if(config.sourceMode == chordSequenceOutputConfig::Scale) {
         outputRoot = static_cast<float>(globalKey);
         int safeScaleIndex = getGlobalScaleSafeIndex();
-        if(safeScaleIndex >= 0 && safeScaleIndex < static_cast<int>(scaleLibrary.size())) {
-            std::vector<float> values = scaleLibrary[safeScaleIndex].values;
+        if(safeScaleIndex >= 0 && safeScaleIndex < static_cast<int>(scaleLibrary->size())) {
+            std::vector<float> values = (*scaleLibrary)[safeScaleIndex].values;
             for(auto &value : values) {
                 value += static_cast<float>(globalKey);
             }
@@ -2454,6 +2476,10 @@ std::vector<float> chordSequence::buildOutputSourceValues(const chordSequenceEnt
 }
 
 float chordSequence::getEntryRootValue(const chordSequenceEntry &entry) const {
+    return getEntryCache(entry).root;
+}
+
+float chordSequence::computeEntryRootValue(const chordSequenceEntry &entry) const {
     if(entry.mode == chordSequenceEntry::Cypher) {
         float rootValue = 0.0f;
         std::string quality;
@@ -2481,7 +2507,11 @@ std::string chordSequence::getEntryDisplayRootLabel(const chordSequenceEntry &en
     return keyNames[pitchClass];
 }
 
-std::vector<float> chordSequence::buildEntryPreviewOutput(const chordSequenceEntry &entry) const {
+const std::vector<float> &chordSequence::buildEntryPreviewOutput(const chordSequenceEntry &entry) const {
+    return getEntryCache(entry).preview;
+}
+
+std::vector<float> chordSequence::computeEntryPreviewOutput(const chordSequenceEntry &entry) const {
     if(entry.mode == chordSequenceEntry::Degree || entry.mode == chordSequenceEntry::Functional) {
         std::vector<float> values = buildDegreeValues(entry);
         for(auto &value : values) {
@@ -2493,7 +2523,7 @@ std::vector<float> chordSequence::buildEntryPreviewOutput(const chordSequenceEnt
     std::vector<float> values = buildEntryIntervals(entry);
     values = applyInversion(values, entry.inversion);
 
-    float rootValue = getEntryRootValue(entry);
+    float rootValue = computeEntryRootValue(entry);
     for(auto &value : values) {
         value += rootValue;
     }
@@ -2501,6 +2531,90 @@ std::vector<float> chordSequence::buildEntryPreviewOutput(const chordSequenceEnt
     return values;
 }
 
+chordSequenceEntryKey chordSequence::makeEntryKey(const chordSequenceEntry &entry) const {
+    chordSequenceEntryKey key;
+    key.mode = entry.mode;
+    key.itemIndex = entry.itemIndex;
+    key.itemName = entry.itemName;
+    key.functionalGroup = entry.functionalGroup;
+    key.functionalVariantIndex = entry.functionalVariantIndex;
+    key.degree = entry.degree;
+    key.chordSize = entry.chordSize;
+    key.stepInterval = entry.stepInterval;
+    key.transpose = entry.transpose;
+    key.inversion = entry.inversion;
+    key.globalKey = globalKey;
+    key.globalScaleIndex = getGlobalScaleSafeIndex();
+    key.libraryGeneration = libraryGeneration;
+    return key;
+}
+
+const chordSequenceEntryCache &chordSequence::getEntryCache(const chordSequenceEntry &entry) const {
+    int index = indexOfElement(progression, entry);
+    chordSequenceEntryCache *cache = &scratchEntryCache;
+    if(index >= 0) {
+        // Growing a deque keeps references to the existing caches valid
+        if(static_cast<int>(entryCaches.size()) <= index) entryCaches.resize(index + 1);
+        cache = &entryCaches[index];
+    }
+
+    chordSequenceEntryKey key = makeEntryKey(entry);
+    if(index < 0 || cache->version == 0 || !(cache->key == key)) {
+        cache->root = computeEntryRootValue(entry);
+        cache->preview = computeEntryPreviewOutput(entry);
+        cache->diatonicReference = computeDiatonicReferenceScale(entry);
+        cache->key = std::move(key);
+        cache->version = ++entryCacheVersion;
+    }
+    return *cache;
+}
+
+bool chordSequence::outputBodyIsDeterministic(const chordSequenceEntry &entry, const chordSequenceOutputConfig &config) const {
+    // Chord Sum depends on every entry, not just this one
+    if(config.sourceMode == chordSequenceOutputConfig::ChordSum) return false;
+    if(config.sourceMode != chordSequenceOutputConfig::Chord) return true;
+    return !modeSupportsDiatonicDeviation(entry.mode) ||
+           entry.diatonicDeviationProbability <= 0.0f ||
+           entry.diatonicDeviationRange <= 0;
+}
+
+std::vector<float> chordSequence::buildOutputBody(const chordSequenceEntry &entry,
+                                                  const chordSequenceOutputConfig &config,
+                                                  float &outputRoot) const {
+    int entryIndex = indexOfElement(progression, entry);
+    int outputIndex = indexOfElement(outputConfigs, config);
+    if(entryIndex < 0 || outputIndex < 0 || !outputBodyIsDeterministic(entry, config)) {
+        std::vector<float> values = buildOutputSourceValues(entry, config, outputRoot);
+        return shapeOutputBody(std::move(values), config, outputRoot);
+    }
+
+    chordSequenceVoicingKey key;
+    key.entryVersion = getEntryCache(entry).version;
+    key.sourceMode = config.sourceMode;
+    key.inversion = config.inversion;
+    key.voicingMode = config.voicingMode;
+    key.voicingSpread = config.voicingSpread;
+    key.fold12 = config.fold12;
+    key.outputSize = config.outputSize;
+    key.addBass = config.addBass;
+    key.expandOutput = config.expandOutput;
+    key.globalInvert = effectiveGlobalInvert;
+    key.globalTranspose = effectiveGlobalTranspose;
+
+    if(static_cast<int>(voicingCaches.size()) <= outputIndex) voicingCaches.resize(outputIndex + 1);
+    std::vector<chordSequenceVoicingCache> &outputCaches = voicingCaches[outputIndex];
+    if(static_cast<int>(outputCaches.size()) <= entryIndex) outputCaches.resize(entryIndex + 1);
+    chordSequenceVoicingCache &cache = outputCaches[entryIndex];
+
+    if(!(cache.key == key)) {
+        std::vector<float> values = buildOutputSourceValues(entry, config, cache.outputRoot);
+        cache.values = shapeOutputBody(std::move(values), config, cache.outputRoot);
+        cache.key = key;
+    }
+    outputRoot = cache.outputRoot;
+    return cache.values;
+}
+
 std::vector<float> chordSequence::applyVoiceLeading(const std::vector<float> &previousValues,
                                                     const std::vector<float> &nextValues,
                                                     int minNote,
@@ -2650,15 +2764,9 @@ std::vector<float> chordSequence::applyVoicingSpread(const std::vector<float> &v
     return spreadValues;
 }
 
-std::vector<float> chordSequence::buildOutputValues(const chordSequenceEntry &entry,
-                                                    const chordSequenceOutputConfig &config,
-                                                    const std::vector<float> &previousValues) const {
-    float outputRoot = 0.0f;
-    std::vector<float> values = buildOutputSourceValues(entry, config, outputRoot);
-
-    // Output processing intentionally flows from harmonic source -> global
-    // transpose/fold -> voicing/size -> stochastic color -> absolute register
-    // -> optional continuity/range cleanup.
+std::vector<float> chordSequence::shapeOutputBody(std::vector<float> values,
+                                                  const chordSequenceOutputConfig &config,
+                                                  float &outputRoot) const {
     if(!outputSourceUsesScaleLikeMaterial(config.sourceMode)) {
         values = applyInversion(values, effectiveGlobalInvert + config.inversion);
     }
@@ -2683,15 +2791,26 @@ std::vector<float> chordSequence::buildOutputValues(const chordSequenceEntry &en
     }
 
     int requestedBodySize = std::max(0, config.outputSize - ((!outputSourceUsesScaleLikeMaterial(config.sourceMode) && config.addBass) ? 1 : 0));
-    values = requestedBodySize == 0
-                 ? std::vector<float>{}
-                 : adaptOutputSize(values, requestedBodySize, config.expandOutput, false);
+    return requestedBodySize == 0
+               ? std::vector<float>{}
+               : adaptOutputSize(values, requestedBodySize, config.expandOutput, false);
+}
+
+std::vector<float> chordSequence::buildOutputValues(const chordSequenceEntry &entry,
+                                                    const chordSequenceOutputConfig &config,
+                                                    const std::vector<float> &previousValues) const {
+    // Output processing intentionally flows from harmonic source -> global
+    // transpose/fold -> voicing/size -> stochastic color -> absolute register
+    // -> optional continuity/range cleanup. Everything up to the size stage is
+    // memoised per entry and output unless a diatonic deviation precedes it.
+    float outputRoot = 0.0f;
+    std::vector<float> values = buildOutputBody(entry, config, outputRoot);
 
     if(config.octaveRandomProbability > 0.0f && config.octaveRandomRange > 0) {
         for(auto &value : values) {
-            if(ofRandom(100.0f) < config.octaveRandomProbability) {
+            if(randomEngine.uniform(100.0f) < config.octaveRandomProbability) {
                 int options = config.octaveRandomRange * 2;
-                int octaveOffset = static_cast<int>(std::floor(ofRandom(static_cast<float>(options)))) - config.octaveRandomRange;
+                int octaveOffset = static_cast<int>(std::floor(randomEngine.uniform(static_cast<float>(options)))) - config.octaveRandomRange;
                 if(octaveOffset >= 0) octaveOffset += 1;
                 value += static_cast<float>(octaveOffset * 12);
             }
@@ -2713,7 +2832,7 @@ std::vector<float> chordSequence::buildOutputValues(const chordSequenceEntry &en
     for(auto &value : values) {
         value += noteOffset + pitchOffset;
         if(config.perNoteDetune > 0.0f) {
-            value += ofRandom(-config.perNoteDetune, config.perNoteDetune);
+            value += randomEngine.uniform(-config.perNoteDetune, config.perNoteDetune);
         }
     }
 
@@ -2890,7 +3009,7 @@ int chordSequence::chooseNextInternalStep(int currentStep) {
         return (currentStep + 1) % sequenceSize;
     }
 
-    float threshold = ofRandom(sum);
+    float threshold = randomEngine.uniform(sum);
     float cumulative = 0.0f;
     for(int i = 0; i < sequenceSize; i++) {
         cumulative += normalized[i];
@@ -3006,7 +3125,7 @@ void chordSequence::beginGlideTo(int outputIndex, const std::vector<float> &next
     }
 
     glideStartOutputs[outputIndex] = currentOutputs[outputIndex];
-    outputGlideStartTimeMs[outputIndex] = ofGetElapsedTimeMillis();
+    outputGlideStartTimeMs[outputIndex] = sequencerContext::get().nowMillis();
     outputIsGliding[outputIndex] = true;
 }
 
@@ -3025,7 +3144,7 @@ std::vector<float> chordSequence::getInterpolatedOutput(int outputIndex, float p
 
 float chordSequence::getGlideProgress(int outputIndex) const {
     if(!outputIsGliding[outputIndex] || outputConfigs[outputIndex].glideMs <= 0.001f) return 1.0f;
-    uint64_t elapsed = ofGetElapsedTimeMillis() - outputGlideStartTimeMs[outputIndex];
+    uint64_t elapsed = sequencerContext::get().nowMillis() - outputGlideStartTimeMs[outputIndex];
     return ofClamp(static_cast<float>(elapsed) / outputConfigs[outputIndex].glideMs, 0.0f, 1.0f);
 }
 
@@ -3263,14 +3382,14 @@ void chordSequence::drawGlobalControls() {
 
         ImGui::TableSetColumnIndex(1);
         sanitizeGlobalScaleSelection();
-        std::string scalePreview = scaleLibrary.empty() ? "---" : scaleLibrary[getGlobalScaleSafeIndex()].name;
+        std::string scalePreview = scaleLibrary->empty() ? "---" : (*scaleLibrary)[getGlobalScaleSafeIndex()].name;
         ImGui::SetNextItemWidth(-FLT_MIN);
         if(ImGui::BeginCombo("Key Scale", scalePreview.c_str())) {
-            for(int i = 0; i < static_cast<int>(scaleLibrary.size()); i++) {
+            for(int i = 0; i < static_cast<int>(scaleLibrary->size()); i++) {
                 bool selected = i == getGlobalScaleSafeIndex();
-                if(ImGui::Selectable(scaleLibrary[i].name.c_str(), selected)) {
+                if(ImGui::Selectable((*scaleLibrary)[i].name.c_str(), selected)) {
                     globalScaleIndex = i;
-                    globalScaleName = scaleLibrary[i].name;
+                    globalScaleName = (*scaleLibrary)[i].name;
                     refreshAllOutputs(true);
                 }
                 if(selected) ImGui::SetItemDefaultFocus();
@@ -3,14 +3,19 @@
 #include "santiNodesTransportCompat.h"
 #include "ofxOceanodeNodeModel.h"
 #ifdef OFX_OCEANODE_HAS_GLOBAL_TRANSPORT
+#include "sequencerContext.h"
+#include "harmonyLibraryStore.h"
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
 #include <random>
 #include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -98,6 +103,71 @@ struct chordSequenceOutputConfig {
     static chordSequenceOutputConfig fromJson(const ofJson &json);
 };
 
+// Everything an entry's deterministic results depend on: its harmonic fields,
+// the global key / scale and the generation of the libraries they are looked up in
+struct chordSequenceEntryKey {
+    int mode = -1;
+    int itemIndex = 0;
+    std::string itemName;
+    int functionalGroup = 0;
+    int functionalVariantIndex = 0;
+    int degree = 0;
+    int chordSize = 0;
+    int stepInterval = 0;
+    int transpose = 0;
+    int inversion = 0;
+    int globalKey = 0;
+    int globalScaleIndex = -1;
+    uint64_t libraryGeneration = 0;
+
+    bool operator==(const chordSequenceEntryKey &other) const {
+        return std::tie(mode, itemIndex, itemName, functionalGroup, functionalVariantIndex, degree, chordSize,
+                        stepInterval, transpose, inversion, globalKey, globalScaleIndex, libraryGeneration) ==
+               std::tie(other.mode, other.itemIndex, other.itemName, other.functionalGroup, other.functionalVariantIndex,
+                        other.degree, other.chordSize, other.stepInterval, other.transpose, other.inversion,
+                        other.globalKey, other.globalScaleIndex, other.libraryGeneration);
+    }
+};
+
+// Memoised results of one progression entry
+struct chordSequenceEntryCache {
+    chordSequenceEntryKey key;
+    uint64_t version = 0;  // 0 = never computed
+    float root = 0.0f;
+    std::vector<float> preview;
+    std::vector<float> diatonicReference;
+};
+
+// The output config fields and global modifiers that shape an output's body
+struct chordSequenceVoicingKey {
+    uint64_t entryVersion = 0;
+    int sourceMode = -1;
+    int inversion = 0;
+    int voicingMode = 0;
+    float voicingSpread = 0.0f;
+    bool fold12 = false;
+    int outputSize = 0;
+    bool addBass = false;
+    bool expandOutput = false;
+    int globalInvert = 0;
+    int globalTranspose = 0;
+
+    bool operator==(const chordSequenceVoicingKey &other) const {
+        return std::tie(entryVersion, sourceMode, inversion, voicingMode, voicingSpread, fold12,
+                        outputSize, addBass, expandOutput, globalInvert, globalTranspose) ==
+               std::tie(other.entryVersion, other.sourceMode, other.inversion, other.voicingMode, other.voicingSpread,
+                        other.fold12, other.outputSize, other.addBass, other.expandOutput,
+                        other.globalInvert, other.globalTranspose);
+    }
+};
+
+// One output's body for one entry (source through size adaptation)
+struct chordSequenceVoicingCache {
+    chordSequenceVoicingKey key;
+    float outputRoot = 0.0f;
+    std::vector<float> values;
+};
+
 struct chordSequenceSnapshot {
     std::vector<chordSequenceEntry> entries;
     std::vector<chordSequenceOutputConfig> outputs;
@@ -174,13 +244,19 @@ private:
 
     ofEventListeners listeners;
 
-    std::vector<chordSequenceLibraryItem> chordLibrary;
-    std::vector<chordSequenceLibraryItem> scaleLibrary;
-    std::unordered_map<std::string, std::array<std::vector<chordSequenceFunctionalVariant>, 3>> functionalHarmonyLibrary;
-    std::unordered_map<std::string, std::string> chordAliases;
+    using LibraryItems = std::vector<chordSequenceLibraryItem>;
+    using FunctionalLibrary = std::unordered_map<std::string, std::array<std::vector<chordSequenceFunctionalVariant>, 3>>;
+    using AliasMap = std::unordered_map<std::string, std::string>;
+
+    // Shared with every other node through harmonyLibraryStore
+    std::shared_ptr<const LibraryItems> chordLibrary;
+    std::shared_ptr<const LibraryItems> scaleLibrary;
+    std::shared_ptr<const FunctionalLibrary> functionalHarmonyLibrary;
+    std::shared_ptr<const AliasMap> chordAliases;
+    std::shared_ptr<const ofJson> jazzStandardsDatabase;
+    std::shared_ptr<const ofJson> importedProgressionSource;  // held so the store keeps watching the file
     std::vector<chordSequenceEntry> progression;
-    ofJson importedProgressionDatabase;
-    ofJson jazzStandardsDatabase;
+    ofJson importedProgressionDatabase;  // own copy, appended to by the import panel
     std::vector<std::string> importedProgressionNames;
     std::vector<std::string> jazzStandardNames;
     int selectedImportedProgression = 0;
@@ -224,7 +300,16 @@ private:
     float editorZoom = 1.0f;
     float editorFontZoom = 1.0f;
     float manualEditorZoom = 1.0f;
-    std::mt19937 randomEngine;
+    mutable sequencerRng randomEngine{this};  // also drawn from const output builders
+    // Memoised output stages, checked against their inputs on every use, so
+    // edits anywhere only recompute the entries they touched
+    mutable std::deque<chordSequenceEntryCache> entryCaches;  // per progression index, never shrinks
+    mutable chordSequenceEntryCache scratchEntryCache;        // entries outside the progression
+    mutable std::vector<std::vector<chordSequenceVoicingCache>> voicingCaches;  // [output][entry]
+    mutable uint64_t entryCacheVersion = 0;
+    // Bumped by loadLibraries(); a freed library view's address may be reused
+    // by the next one, so caches compare this rather than the pointers
+    uint64_t libraryGeneration = 0;
     bool snapshotsSectionExpanded = true;
     bool globalSectionExpanded = true;
     bool randomationSectionExpanded = true;
@@ -255,7 +340,8 @@ private:
     void loadCypherAliases();
     void loadFunctionalHarmony();
     std::string resolvePitchClassFile(const std::string &fileName) const;
-    std::vector<chordSequenceLibraryItem> parsePitchClassFile(const std::string &path) const;
+    static LibraryItems parsePitchClassFile(const std::string &path);
+    static FunctionalLibrary parseFunctionalHarmony(const std::string &path);
     void loadImportSources();
     void reloadLibraries();
 
@@ -297,7 +383,8 @@ private:
     void applyFunctionalVariantToEntry(chordSequenceEntry &entry) const;
     std::vector<float> buildDegreeValues(const chordSequenceEntry &entry) const;
     std::vector<float> buildEntryIntervals(const chordSequenceEntry &entry) const;
-    std::vector<float> getDiatonicReferenceScale(const chordSequenceEntry &entry) const;
+    const std::vector<float> &getDiatonicReferenceScale(const chordSequenceEntry &entry) const;
+    std::vector<float> computeDiatonicReferenceScale(const chordSequenceEntry &entry) const;
     std::vector<float> applyDiatonicDeviation(const std::vector<float> &values, const chordSequenceEntry &entry) const;
     std::vector<float> applyChromaticDeviation(const std::vector<float> &values,
                                                float probability,
@@ -307,9 +394,20 @@ private:
                                                const chordSequenceOutputConfig &config,
                                                float &outputRoot) const;
     float getEntryRootValue(const chordSequenceEntry &entry) const;
+    float computeEntryRootValue(const chordSequenceEntry &entry) const;
     float getEntryDisplayRootPitchClass(const chordSequenceEntry &entry) const;
     std::string getEntryDisplayRootLabel(const chordSequenceEntry &entry) const;
-    std::vector<float> buildEntryPreviewOutput(const chordSequenceEntry &entry) const;
+    const std::vector<float> &buildEntryPreviewOutput(const chordSequenceEntry &entry) const;
+    std::vector<float> computeEntryPreviewOutput(const chordSequenceEntry &entry) const;
+    chordSequenceEntryKey makeEntryKey(const chordSequenceEntry &entry) const;
+    const chordSequenceEntryCache &getEntryCache(const chordSequenceEntry &entry) const;
+    bool outputBodyIsDeterministic(const chordSequenceEntry &entry, const chordSequenceOutputConfig &config) const;
+    std::vector<float> buildOutputBody(const chordSequenceEntry &entry,
+                                       const chordSequenceOutputConfig &config,
+                                       float &outputRoot) const;
+    std::vector<float> shapeOutputBody(std::vector<float> values,
+                                       const chordSequenceOutputConfig &config,
+                                       float &outputRoot) const;
     std::vector<float> applyVoicing(const std::vector<float> &values, int voicingMode) const;
     std::vector<float> applyVoicingSpread(const std::vector<float> &values, float spread) const;
     std::vector<float> applyVoiceLeading(const std::vector<float> &previousValues,
@@ -2,7 +2,7 @@
 #define csv2vector_h
 
 #include "ofxOceanodeNodeModel.h"
-#include <sstream>
+#include "csvParser.h"
 #include <string>
 #include <vector>
 #include <limits>
@@ -31,23 +31,10 @@ private:
     ofEventListeners listeners;
 
     void parseCSV(const string &csv) {
-        vector<float> result;
-        stringstream ss(csv);
-        string item;
-
-        while (getline(ss, item, ',')) {
-            // Trim whitespace
-            item.erase(0, item.find_first_not_of(" \t\n\r\f\v"));
-            item.erase(item.find_last_not_of(" \t\n\r\f\v") + 1);
-
-            try {
-                float value = stof(item);
-                result.push_back(value);
-            } catch (const std::invalid_argument& ia) {
-                ofLogWarning("csvToVector") << "Invalid number in CSV: " << item;
-            } catch (const std::out_of_range& oor) {
-                ofLogWarning("csvToVector") << "Number out of range in CSV: " << item;
-            }
+        csvParseReport report;
+        vector<float> result = csvParser::parseNumbers(csv, report);
+        if (!report.ok()) {
+            ofLogWarning("csvToVector") << report.describe();
         }
 
         if (result.empty()) {
@@ -0,0 +1,241 @@
+#ifndef csvParser_h
+#define csvParser_h
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Rows of floats stored back to back in one arena, with the offset at which
+// each row starts. Rows are read through lightweight views, so a 100k-row file
+// costs one allocation instead of one per row.
+class csvTable {
+public:
+	class Row {
+	public:
+		Row(const float *data, size_t count) : first(data), count(count) {}
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		float operator[](size_t i) const { return first[i]; }
+		const float *begin() const { return first; }
+		const float *end() const { return first + count; }
+		std::vector<float> toVector() const { return std::vector<float>(begin(), end()); }
+
+	private:
+		const float *first;
+		size_t count;
+	};
+
+	class const_iterator {
+	public:
+		const_iterator(const csvTable *table, size_t row) : table(table), row(row) {}
+		Row operator*() const { return (*table)[row]; }
+		const_iterator &operator++() { row++; return *this; }
+		bool operator!=(const const_iterator &other) const { return row != other.row; }
+
+	private:
+		const csvTable *table;
+		size_t row;
+	};
+
+	size_t size() const { return offsets.size() - 1; }
+	bool empty() const { return size() == 0; }
+	Row operator[](size_t row) const { return Row(values.data() + offsets[row], offsets[row + 1] - offsets[row]); }
+	Row front() const { return (*this)[0]; }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, size()); }
+
+	size_t maxRowSize() const {
+		size_t widest = 0;
+		for(size_t r = 0; r < size(); r++) widest = std::max(widest, offsets[r + 1] - offsets[r]);
+		return widest;
+	}
+
+	void clear() {
+		values.clear();
+		offsets.assign(1, 0);
+	}
+
+	void reserve(size_t numValues, size_t numRows) {
+		values.reserve(numValues);
+		offsets.reserve(numRows + 1);
+	}
+
+	void push_back(const std::vector<float> &row) {
+		values.insert(values.end(), row.begin(), row.end());
+		endRow();
+	}
+
+	// Replaces a row; rows after it move only when the size changes
+	void setRow(size_t row, const std::vector<float> &newValues) {
+		size_t start = offsets[row];
+		size_t oldSize = offsets[row + 1] - start;
+		if(newValues.size() != oldSize) {
+			values.erase(values.begin() + start, values.begin() + start + oldSize);
+			values.insert(values.begin() + start, newValues.size(), 0.0f);
+			for(size_t r = row + 1; r < offsets.size(); r++) offsets[r] = offsets[r] - oldSize + newValues.size();
+		}
+		std::copy(newValues.begin(), newValues.end(), values.begin() + start);
+	}
+
+	// For parsers: values go to the open row until endRow()
+	void addValue(float value) { values.push_back(value); }
+	void endRow() { offsets.push_back(values.size()); }
+
+private:
+	std::vector<float> values;
+	std::vector<size_t> offsets{0};  // size() + 1 entries
+};
+
+// Cells that could not be read. Parsing never throws: bad cells are skipped,
+// counted, and the first few kept for the log.
+struct csvParseReport {
+	struct Cell {
+		size_t line;    // 1-based
+		size_t column;  // 0-based
+		std::string text;
+	};
+	static constexpr size_t MAX_KEPT = 8;
+
+	size_t badCells = 0;
+	std::vector<Cell> firstBadCells;
+
+	bool ok() const { return badCells == 0; }
+
+	void add(size_t line, size_t column, std::string_view text) {
+		if(firstBadCells.size() < MAX_KEPT) firstBadCells.push_back({line, column, std::string(text)});
+		badCells++;
+	}
+
+	std::string describe() const {
+		std::string s = std::to_string(badCells) + (badCells == 1 ? " unreadable cell:" : " unreadable cells:");
+		for(const auto &cell : firstBadCells) {
+			s += " line " + std::to_string(cell.line) + " column " + std::to_string(cell.column) + " '" + cell.text + "';";
+		}
+		if(badCells > firstBadCells.size()) s += " ...";
+		return s;
+	}
+};
+
+namespace csvParser {
+	constexpr const char *WHITESPACE = " \t\n\r\f\v";
+	constexpr size_t CHUNK_BYTES = 1 << 20;
+
+	inline std::string_view trim(std::string_view s) {
+		size_t first = s.find_first_not_of(WHITESPACE);
+		if(first == std::string_view::npos) return {};
+		return s.substr(first, s.find_last_not_of(WHITESPACE) - first + 1);
+	}
+
+	// Calls f(field, column) for each untrimmed field. Like std::getline, a
+	// separator at the very end doesn't start another field.
+	template<typename F>
+	void forEachField(std::string_view line, char separator, F &&f) {
+		size_t start = 0;
+		size_t column = 0;
+		while(start < line.size()) {
+			size_t end = line.find(separator, start);
+			if(end == std::string_view::npos) end = line.size();
+			f(line.substr(start, end - start), column++);
+			start = end + 1;
+		}
+	}
+
+	// Reads a cell the way std::stof did (surrounding whitespace and a leading
+	// '+' allowed, trailing text ignored) without exceptions. False when there
+	// is no number or it is out of float range.
+	inline bool parseFloat(std::string_view cell, float &value) {
+		cell = trim(cell);
+		if(!cell.empty() && cell.front() == '+') cell.remove_prefix(1);
+		if(cell.empty()) return false;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		auto result = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+		return result.ec == std::errc();
+#else
+		// Standard libraries without floating-point from_chars
+		char text[64];
+		size_t n = std::min(cell.size(), sizeof(text) - 1);
+		std::memcpy(text, cell.data(), n);
+		text[n] = '\0';
+		char *end = nullptr;
+		errno = 0;
+		value = std::strtof(text, &end);
+		return end != text && errno != ERANGE;
+#endif
+	}
+
+	// One line of comma-separated numbers as a new table row
+	inline void parseRow(std::string_view line, size_t lineNumber, csvTable &out, csvParseReport &report) {
+		if(!line.empty() && line.back() == '\r') line.remove_suffix(1);
+		forEachField(line, ',', [&](std::string_view field, size_t column) {
+			float value;
+			if(parseFloat(field, value)) {
+				out.addValue(value);
+			} else {
+				report.add(lineNumber, column, field);
+			}
+		});
+		out.endRow();
+	}
+
+	// Comma-separated numbers from a string (a single row)
+	inline std::vector<float> parseNumbers(std::string_view text, csvParseReport &report) {
+		std::vector<float> result;
+		forEachField(text, ',', [&](std::string_view field, size_t column) {
+			float value;
+			if(parseFloat(field, value)) {
+				result.push_back(value);
+			} else {
+				report.add(1, column, field);
+			}
+		});
+		return result;
+	}
+
+	// Streams the file through a fixed buffer, one row per line, so memory
+	// stays at the table itself plus one chunk. False if it can't be opened.
+	inline bool parseFile(const std::string &path, csvTable &out, csvParseReport &report) {
+		std::ifstream file(path, std::ios::binary);
+		if(!file.is_open()) return false;
+
+		out.clear();
+		report = csvParseReport();
+		file.seekg(0, std::ios::end);
+		std::streamoff bytes = file.tellg();
+		file.seekg(0, std::ios::beg);
+		if(bytes > 0) out.reserve(size_t(bytes) / 8, size_t(bytes) / 64);
+
+		std::vector<char> buffer(CHUNK_BYTES);
+		size_t filled = 0;
+		size_t lineNumber = 1;
+		while(true) {
+			// A line longer than the buffer: make room for the rest of it
+			if(filled == buffer.size()) buffer.resize(buffer.size() * 2);
+			file.read(buffer.data() + filled, std::streamsize(buffer.size() - filled));
+			filled += size_t(file.gcount());
+			bool atEnd = !file;
+
+			std::string_view text(buffer.data(), filled);
+			size_t consumed = 0;
+			for(size_t newline; (newline = text.find('\n', consumed)) != std::string_view::npos; consumed = newline + 1) {
+				parseRow(text.substr(consumed, newline - consumed), lineNumber++, out, report);
+			}
+
+			if(atEnd) {
+				// Last line without a trailing newline
+				if(consumed < filled) parseRow(text.substr(consumed), lineNumber, out, report);
+				break;
+			}
+			std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+			filled -= consumed;
+		}
+		return true;
+	}
+}
+
+#endif /* csvParser_h */
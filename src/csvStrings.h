@@ -2,6 +2,7 @@
 #define CSV_STRINGS_H
 
 #include "ofxOceanodeNodeModel.h"
+#include "csvParser.h"
 
 class csvStrings : public ofxOceanodeNodeModel {
 public:
@@ -39,18 +40,14 @@ private:
     
     void processInput() {
         strings.clear();
-        string currentInput = input.get();
         
-        // Split the input string by commas
-        vector<string> tokens = ofSplitString(currentInput, ",");
-        
-        // Clean and store each token
-        for(const auto& token : tokens) {
-            string cleanToken = ofTrim(token);
+        // Split the input string by commas, keeping the non-empty trimmed tokens
+        csvParser::forEachField(input.get(), ',', [this](std::string_view token, size_t) {
+            std::string_view cleanToken = csvParser::trim(token);
             if(!cleanToken.empty()) {
-                strings.push_back(cleanToken);
+                strings.emplace_back(cleanToken);
             }
-        }
+        });
         
         // Update size parameter
         size.set(strings.size());
@@ -0,0 +1,168 @@
+#ifndef curveSegmentCache_h
+#define curveSegmentCache_h
+
+#include "ofMain.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Flattened copy of a sigmoid-segment curve (control points plus one
+// inflection / steepness pair per segment), shared by curveTrack and
+// sigmoidCurve for evaluation.
+//
+// Segment lookup first tries the segment found by the previous call and its
+// neighbours, then falls back to a binary search, so sweeping readers (a
+// playhead, a row of LED phasors) resolve in O(1). Exact evaluation folds the
+// two pow() calls of sigmoidFlex into one; with a LUT resolution of 2 or more
+// each segment's shape is instead baked into that many samples and read with
+// linear interpolation.
+class curveSegmentCache {
+public:
+	// getX(point) returns the point's position (beat or normalized phase)
+	template<typename Point, typename Tension, typename GetX>
+	void build(const std::vector<Point>& points, const std::vector<Tension>& tensions, GetX getX, int lutResolution) {
+		size_t n = points.size();
+		xs.resize(n);
+		values.resize(n);
+		for(size_t i = 0; i < n; i++) {
+			xs[i] = getX(points[i]);
+			values[i] = points[i].value;
+		}
+		size_t segments = n > 0 ? n - 1 : 0;
+		inflections.assign(segments, 0.5f);
+		steepnesses.assign(segments, 1.0f);
+		for(size_t i = 0; i < segments && i < tensions.size(); i++) {
+			inflections[i] = tensions[i].inflection;
+			steepnesses[i] = tensions[i].steepness;
+		}
+		odds.resize(segments);
+		exponents.resize(segments);
+		for(size_t i = 0; i < segments; i++) {
+			float p = ofClamp(ofClamp(inflections[i], 0.01f, 0.99f), 0.0001f, 0.9999f);
+			odds[i] = p / (1.0f - p);
+			exponents[i] = ofClamp(steepnesses[i], 0.05f, 10.0f);
+		}
+
+		lutRes = lutResolution >= 2 ? lutResolution : 0;
+		lut.resize(segments * lutRes);
+		for(size_t s = 0; s < segments && lutRes > 0; s++) {
+			for(int j = 0; j < lutRes; j++) {
+				lut[s * lutRes + j] = sigmoidFlex(j / float(lutRes - 1), inflections[s], steepnesses[s]);
+			}
+		}
+
+		cursor = 0;
+		dirty = false;
+	}
+
+	void invalidate() { dirty = true; }
+	bool isDirty() const { return dirty; }
+
+	// Matches the linear scan it replaces: clamps outside the points and
+	// returns the left value on segments shorter than 0.001
+	float evaluate(double x) {
+		size_t n = xs.size();
+		if(n == 0) return 0.0f;
+		if(n == 1) return values[0];
+		if(x <= xs.front()) return values.front();
+		if(x >= xs.back()) return values.back();
+
+		return evaluateIn(findSegment(x), x);
+	}
+
+	// Writes evaluate(x0 + i * step) for i < count (step >= 0), walking the
+	// segments forward instead of looking each sample up
+	void render(double x0, double step, int count, float* out) {
+		size_t n = xs.size();
+		if(n < 2) {
+			std::fill(out, out + count, n == 0 ? 0.0f : values[0]);
+			return;
+		}
+		size_t seg = 0;
+		bool   found = false;
+		for(int i = 0; i < count; i++) {
+			double x = x0 + i * step;
+			if(x <= xs.front()) { out[i] = values.front(); continue; }
+			if(x >= xs.back())  { out[i] = values.back();  continue; }
+			if(!found) { seg = findSegment(x); found = true; }
+			while(x > xs[seg + 1]) seg++;
+			out[i] = evaluateIn(seg, x);
+		}
+		if(found) cursor = seg;
+	}
+
+	static float sigmoidFlex(float x, float p, float k) {
+		x = ofClamp(x, 0.0f, 1.0f);
+		p = ofClamp(p, 0.01f, 0.99f);
+		k = ofClamp(k, 0.05f, 10.0f);
+
+		const float epsilon = 0.0001f;
+		if(x < epsilon) return 0.0f;
+		if(x > 1.0f - epsilon) return 1.0f;
+
+		float xSafe = ofClamp(x, epsilon, 1.0f - epsilon);
+		float pSafe = ofClamp(p, epsilon, 1.0f - epsilon);
+
+		float a = pow(xSafe / pSafe, k);
+		float b = pow((1.0f - xSafe) / (1.0f - pSafe), k);
+
+		float denominator = a + b;
+		if(denominator < epsilon) return 0.5f;
+
+		return a / denominator;
+	}
+
+private:
+	// Value inside segment i, xs[i] < x <= xs[i + 1]
+	float evaluateIn(size_t i, double x) const {
+		double segmentLength = xs[i + 1] - xs[i];
+		if(segmentLength < 0.001) return values[i];
+
+		float t = (x - xs[i]) / segmentLength;
+		float shape;
+		if(lutRes > 0) {
+			float f = ofClamp(t, 0.0f, 1.0f) * (lutRes - 1);
+			int j = std::min((int)f, lutRes - 2);
+			const float* row = &lut[i * lutRes];
+			shape = row[j] + (f - j) * (row[j + 1] - row[j]);
+		} else {
+			shape = shapeAt(i, t);
+		}
+		return values[i] + shape * (values[i + 1] - values[i]);
+	}
+
+	// sigmoidFlex with one pow: a / (a + b) == 1 / (1 + (b / a)), where
+	// b / a = ((1 - x) / x * p / (1 - p))^k
+	float shapeAt(size_t i, float x) const {
+		const float epsilon = 0.0001f;
+		if(x < epsilon) return 0.0f;
+		if(x > 1.0f - epsilon) return 1.0f;
+		return 1.0f / (1.0f + pow((1.0f - x) / x * odds[i], exponents[i]));
+	}
+
+	std::vector<double> xs;
+	std::vector<float>  values;
+	std::vector<float>  inflections;
+	std::vector<float>  steepnesses;
+	std::vector<float>  odds;       // clamped p / (1 - p) per segment
+	std::vector<float>  exponents;  // clamped k per segment
+	std::vector<float>  lut;    // lutRes samples per segment, 0..1 shape
+	int    lutRes = 0;
+	size_t cursor = 0;          // segment found by the last lookup
+	bool   dirty = true;
+
+	// Segment i with xs[i] < x <= xs[i + 1]; requires xs.front() < x < xs.back()
+	size_t findSegment(double x) {
+		size_t last = xs.size() - 2;
+		auto inside = [&](size_t i) { return xs[i] < x && x <= xs[i + 1]; };
+		if(cursor <= last) {
+			if(inside(cursor)) return cursor;
+			if(cursor < last && inside(cursor + 1)) return ++cursor;
+			if(cursor > 0 && inside(cursor - 1)) return --cursor;
+		}
+		cursor = (std::lower_bound(xs.begin(), xs.end(), x) - xs.begin()) - 1;
+		return cursor;
+	}
+};
+
+#endif /* curveSegmentCache_h */
@@ -4,6 +4,7 @@
 #include "ofxOceanodeNodeModel.h"
 #include "ofxOceanodeShared.h"
 #include "imgui.h"
+#include "curveSegmentCache.h"
 #include "ppqTimeline.h"
 #include "transportTrack.h"
 #include <algorithm>
@@ -44,6 +45,7 @@ public:
 		
 		addParameter(minValue.set("Min Value", 0.0f, -10.0f, 10.0f));
 		addParameter(maxValue.set("Max Value", 1.0f, -10.0f, 10.0f));
+		addParameter(lutResolution.set("LUT Res", 0, 0, 4096));
 		addParameter(clipStart   .set("Clip Start",   0.f,   0.f, 999.f));
 		addParameter(clipEnd     .set("Clip End",    999.f,  0.f, 999.f));
 		addParameter(clipDuration.set("Clip Dur",      4.f, 0.25f, 64.f));
@@ -63,6 +65,9 @@ public:
 		listeners.push(numCurves.newListener([this](int &val){
 			resizeCurves(val);
 		}));
+		listeners.push(lutResolution.newListener([this](int &val){
+			invalidateCurve(-1);
+		}));
 		
 		curveOutput.setSerializable(false);
 		
@@ -542,6 +547,7 @@ public:
 					newSteepness,
 					0.05f, 10.0f  // Wider range with better distribution
 				);
+				invalidateCurve(activeCurve);
 			}
 		}
 		
@@ -610,6 +616,26 @@ public:
 	void   setClipDuration(double v) override { clipDuration.set((float)ofClamp(v, 0.25, 64.0)); }
 	void   setClipLoop(bool v)       override { clipLoop.set(v); }
 
+	// Block rendering — one channel per curve, segment walk per clip pass
+	int getRenderChannelCount() const override { return numCurves.get(); }
+
+	bool renderBlock(int channel, double beatFrom, double beatTo, int numSamples, float* out) override {
+		if(channel < 0 || channel >= numCurves.get() || numSamples <= 0) return false;
+		float  lo    = minValue.get();
+		float  range = maxValue.get() - minValue.get();
+		double step  = std::max(0.0, beatTo - beatFrom) / numSamples;
+		double cs0   = getClipStartAt(0); // curve data is in primary clip space
+		std::fill(out, out + numSamples, lo);
+		if(channel >= allCurvePoints.size()) return true;
+
+		curveSegmentCache& cache = getCurveCache(channel);
+		forEachClipRun(beatFrom, step, numSamples, [&](int i0, int i1, double base) {
+			cache.render(cs0 + (beatFrom - base) + i0 * step, step, i1 - i0, out + i0);
+			for(int i = i0; i < i1; i++) out[i] = lo + out[i] * range;
+		});
+		return true;
+	}
+
 	// Content stretching — scale all curve point beats relative to primary clip start
 	void beginContentStretch() override {
 		curveStretchSnap.clear();
@@ -628,6 +654,7 @@ public:
 				allCurvePoints[i][j].beat = cs0 + (curveStretchSnap[i][j].first - cs0) * factor;
 			}
 		}
+		invalidateCurve(-1);
 	}
 
 	// Mini content — draw curve line inside clip bar
@@ -734,6 +761,7 @@ public:
 				allCurveTensions.push_back(curveTensions);
 			}
 		}
+		invalidateCurve(-1);
 		
 		if(json.count("trackHeight") > 0) {
 			trackHeight = json["trackHeight"];
@@ -761,6 +789,7 @@ private:
 	ofParameter<int>         numCurves;
 	ofParameter<float>       minValue;
 	ofParameter<float>       maxValue;
+	ofParameter<int>         lutResolution;   // samples per segment, 0 = evaluate exactly
 	ofParameter<float>       clipStart;
 	ofParameter<float>       clipEnd;
 	ofParameter<float>       clipDuration;
@@ -772,6 +801,7 @@ private:
 	// Multiple curves data
 	std::vector<std::vector<CurveControlPoint>> allCurvePoints;
 	std::vector<std::vector<CurveTension>> allCurveTensions;
+	std::vector<curveSegmentCache> curveCaches; // one per curve, rebuilt when its points/tensions change
 	std::vector<std::vector<std::pair<double,float>>> curveStretchSnap; // for beginContentStretch
 	int activeCurve = 0;
 	
@@ -825,37 +855,10 @@ private:
 		return true;
 	}
 	
-	// Improved sigmoid function with smooth transition and better edge handling
-	float sigmoidFlex(float x, float p, float k) {
-		// Clamp inputs
-		x = ofClamp(x, 0.0f, 1.0f);
-		p = ofClamp(p, 0.01f, 0.99f);
-		k = ofClamp(k, 0.05f, 10.0f);
-		
-		// Handle edge cases with small epsilon to avoid numerical issues
-		const float epsilon = 0.0001f;
-		if(x < epsilon) return 0.0f;
-		if(x > 1.0f - epsilon) return 1.0f;
-		
-		// Ensure we don't divide by values too close to 0
-		float xSafe = ofClamp(x, epsilon, 1.0f - epsilon);
-		float pSafe = ofClamp(p, epsilon, 1.0f - epsilon);
-		
-		// Standard sigmoid formula with safe values
-		float a = pow(xSafe / pSafe, k);
-		float b = pow((1.0f - xSafe) / (1.0f - pSafe), k);
-		
-		// Avoid division by very small numbers
-		float denominator = a + b;
-		if(denominator < epsilon) return 0.5f;
-		
-		return a / denominator;
-	}
-	
 	// Evaluate curve segment between two points
 	float evaluateSegment(const CurveControlPoint& p1, const CurveControlPoint& p2, const CurveTension& tension, float t) {
 		// t is normalized [0,1] position between p1 and p2
-		float curveValue = sigmoidFlex(t, tension.inflection, tension.steepness);
+		float curveValue = curveSegmentCache::sigmoidFlex(t, tension.inflection, tension.steepness);
 		
 		// Interpolate between p1.value and p2.value using the curve
 		return p1.value + curveValue * (p2.value - p1.value);
@@ -864,29 +867,31 @@ private:
 	// Evaluate entire curve at a specific beat for a given curve index
 	float evaluateCurveAt(double beat, int curveIdx) {
 		if(curveIdx < 0 || curveIdx >= allCurvePoints.size()) return 0.0f;
-		
-		auto& points = allCurvePoints[curveIdx];
-		auto& tensions = allCurveTensions[curveIdx];
-		
-		if(points.empty()) return 0.0f;
-		if(points.size() == 1) return points[0].value;
-		
-		// Find which segment the beat falls in
-		if(beat <= points.front().beat) return points.front().value;
-		if(beat >= points.back().beat) return points.back().value;
-		
-		for(size_t i = 0; i < points.size() - 1; i++) {
-			if(beat >= points[i].beat && beat <= points[i + 1].beat) {
-				// Found the segment
-				double segmentLength = points[i + 1].beat - points[i].beat;
-				if(segmentLength < 0.001) return points[i].value;
-				
-				float t = (beat - points[i].beat) / segmentLength;
-				return evaluateSegment(points[i], points[i + 1], tensions[i], t);
-			}
+		return getCurveCache(curveIdx).evaluate(beat);
+	}
+	
+	// Cache for a valid curve index, rebuilt if its points/tensions changed
+	curveSegmentCache& getCurveCache(int curveIdx) {
+		if(curveCaches.size() != allCurvePoints.size()) curveCaches.resize(allCurvePoints.size());
+		
+		auto& cache = curveCaches[curveIdx];
+		if(cache.isDirty()) {
+			static const std::vector<CurveTension> noTensions;
+			cache.build(allCurvePoints[curveIdx],
+						curveIdx < allCurveTensions.size() ? allCurveTensions[curveIdx] : noTensions,
+						[](const CurveControlPoint& pt) { return pt.beat; },
+						lutResolution.get());
+		}
+		return cache;
+	}
+	
+	// Call after points or tensions of a curve change (-1 = all curves)
+	void invalidateCurve(int curveIdx) {
+		if(curveIdx < 0) {
+			for(auto& cache : curveCaches) cache.invalidate();
+		} else if(curveIdx < curveCaches.size()) {
+			curveCaches[curveIdx].invalidate();
 		}
-		
-		return points.back().value;
 	}
 	
 	// Rebuild tensions array when points change for a specific curve
@@ -905,6 +910,8 @@ private:
 		while(tensions.size() > neededTensions) {
 			tensions.pop_back();
 		}
+		
+		invalidateCurve(curveIdx);
 	}
 	
 	// Find closest curve segment to mouse position for a specific curve
@@ -975,6 +982,7 @@ private:
 			allCurvePoints.pop_back();
 			allCurveTensions.pop_back();
 		}
+		invalidateCurve(-1);
 		
 		// Clamp active curve
 		if(activeCurve >= newNumCurves) {
@@ -2,6 +2,7 @@
 #define DATABUFFER_H
 
 #include "ofxOceanodeNodeModel.h"
+#include "dataRing.h"
 
 class dataBuffer : public ofxOceanodeNodeModel{
 public:
@@ -10,57 +11,49 @@ public:
     void setup(){
         addParameter(input.set("Input", {0}, {-FLT_MAX}, {FLT_MAX}));
         addParameter(delayFrames.set("Frames", {0}, {0}, {INT_MAX}));
+        addParameter(delayMs.set("Delay ms", {0}, {0}, {FLT_MAX}));
+        addParameterDropdown(unit, "Unit", 0, {"Frames", "Ms"});
+        addParameterDropdown(interpolation, "Interp", 1, {"None", "Linear", "Cubic"});
         addParameter(bufferSize.set("Buffer Size", 10, 1, INT_MAX)); // New parameter
         addOutputParameter(output.set("Output", {0}, {-FLT_MAX}, {FLT_MAX}));
 
         bufferSizeListener = bufferSize.newListener([this](int &sz){
-            // Resize the buffer to new size, handling overflow or expansion
-            while(store.size() > sz){
-                store.pop_front();
-            }
+            // Drop the oldest frames right away when shrinking
+            store.reshape(sz, store.getWidth());
         });
     }
 
     void update(ofEventArgs &a)
     {
-        store.push_back(input.get());
-
-        // Maintaining the buffer size
-        while(store.size() > bufferSize){
-            store.pop_front();
-        }
+        const vector<float> &in = input.get();
+        double now = ofGetElapsedTimeMicros() / 1000.0;
+        store.reshape(bufferSize, in.size());
+        store.push(in, now);
 
-        vector<int> newDelayFrames = delayFrames.get(); // Create a copy of the current delay frames
-
-        // Ensure newDelayFrames has at least the same number of elements as input
-        while(newDelayFrames.size() < input.get().size())
+        outAux.resize(in.size());
+        if(unit == 1)
         {
-            int lastFrame = newDelayFrames.back();
-            newDelayFrames.push_back(lastFrame); // Modify the copy
+            // Ms delays read between frames, so they stay smooth at any frame rate
+            const vector<float> &delays = delayMs.get();
+            auto mode = static_cast<dataRing::Interpolation>(interpolation.get());
+            for(int i = 0; i < in.size(); i++)
+            {
+                float ms = delays.empty() ? 0 : delays[std::min<size_t>(i, delays.size() - 1)];
+                outAux[i] = store.sample(store.ageAt(now - ms), i, mode);
+            }
         }
-
-        vector<float> outAux;
-        for(int i = 0; i < input.get().size(); i++)
+        else
         {
+            // Missing per-channel delays repeat the last one given
+            const vector<int> &delays = delayFrames.get();
             int storeSize = store.size();
-            int delayFrameI = newDelayFrames[i]; // Use the modified copy
-            int pos = storeSize - delayFrameI - 1;
-            float f = 0;
-            if(pos >= 0 && pos < storeSize)
-            {
-                // Valid position in the buffer
-                f = store[pos][i];
-            }
-            else
+            for(int i = 0; i < in.size(); i++)
             {
+                int delayFrameI = delays.empty() ? 0 : delays[std::min<size_t>(i, delays.size() - 1)];
                 // Closest valid position in the buffer
-                int closestPos = std::max(0, std::min(pos, storeSize - 1));
-                if (!store.empty())
-                {
-                    f = store[closestPos][i];
-                }
+                int age = std::max(0, std::min(delayFrameI, storeSize - 1));
+                outAux[i] = store.frame(age)[i];
             }
-            outAux.push_back(f);
         }
         output = outAux;
     }
@@ -68,12 +61,15 @@ public:
 
 private:
     ofEventListener bufferSizeListener;
-    ofEventListener delayFramesListener;
 
     ofParameter<vector<float>> input;
     ofParameter<vector<int>> delayFrames;
+    ofParameter<vector<float>> delayMs;
+    ofParameter<int> unit;
+    ofParameter<int> interpolation;
     ofParameter<int> bufferSize; // New parameter
     ofParameter<vector<float>> output;
-    deque<vector<float>> store;
+    dataRing store;
+    vector<float> outAux;
 };
 #endif /* DATABUFFER_H */
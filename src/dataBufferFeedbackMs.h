@@ -2,6 +2,7 @@
 #define DATABUFFERFEEDBACKMS_H
 
 #include "ofxOceanodeNodeModel.h"
+#include "dataRing.h"
 
 class dataBufferFeedbackMs : public ofxOceanodeNodeModel {
 public:
@@ -14,63 +15,37 @@ public:
 		addParameter(delayMs.set("Delay ms", {500}, {0}, {10000}));
 		addParameter(feedback.set("Feedback", 0.5f, 0.0f, 0.999f));
 		addParameter(bufferMaxSize.set("Buffer Max Size", 1000, 10, INT_MAX));
+		addParameterDropdown(interpolation, "Interp", 0, {"None", "Linear", "Cubic"});
 		addOutputParameter(output.set("Output", {0}, {-FLT_MAX}, {FLT_MAX}));
-		
-		// Initialize time
-		lastUpdateTime = ofGetElapsedTimeMillis();
 	}
 	
 	void update(ofEventArgs &a) override {
-		// Get current time
-		uint64_t currentTime = ofGetElapsedTimeMillis();
-		
-		// Store current input with timestamp
-		TimeStampedData newEntry;
-		newEntry.timestamp = currentTime;
-		newEntry.data = input.get();
-		inputBuffer.push_back(newEntry);
+		const vector<float> &in = input.get();
+		double now = ofGetElapsedTimeMicros() / 1000.0;
 		
-		// Maintain buffer size limit
-		while (inputBuffer.size() > bufferMaxSize) {
-			inputBuffer.pop_front();
-		}
+		// Store current input with timestamp; the oldest frame is overwritten once full
+		inputBuffer.reshape(bufferMaxSize, in.size());
+		inputBuffer.push(in, now);
 		
-		// Get current delay values in milliseconds
-		vector<float> currentDelayMs = delayMs.get();
-		
-		// Ensure delay vector is same size as input
-		while (currentDelayMs.size() < input.get().size()) {
-			currentDelayMs.push_back(currentDelayMs.empty() ? 0 : currentDelayMs.back());
-		}
+		// Missing per-channel delays repeat the last one given
+		const vector<float> &delays = delayMs.get();
+		auto mode = static_cast<dataRing::Interpolation>(interpolation.get());
+		double oldest = inputBuffer.timeAt(inputBuffer.size() - 1);
 		
 		// Initialize output if needed
-		if (currentOutput.empty() || currentOutput.size() != input.get().size()) {
-			currentOutput.resize(input.get().size(), 0.0f);
+		if (currentOutput.size() != in.size()) {
+			currentOutput.resize(in.size(), 0.0f);
 		}
 		
 		// Process each element in the vector
-		for (size_t i = 0; i < input.get().size(); i++) {
-			// Calculate target timestamp for this element
-			uint64_t targetTime = currentTime - static_cast<uint64_t>(currentDelayMs[i]);
+		for (size_t i = 0; i < in.size(); i++) {
+			float ms = delays.empty() ? 0 : delays[std::min(i, delays.size() - 1)];
+			double targetTime = now - ms;
 			
-			// Get delayed input value from buffer
+			// Nothing was recorded that long ago yet: use zero as the delayed input
 			float delayedInput = 0.0f;
-			bool foundDelayedValue = false;
-			
-			// Find the entry with timestamp closest to target time
-			for (int j = inputBuffer.size() - 1; j >= 0; j--) {
-				if (inputBuffer[j].timestamp <= targetTime) {
-					if (i < inputBuffer[j].data.size()) {
-						delayedInput = inputBuffer[j].data[i];
-						foundDelayedValue = true;
-						break;
-					}
-				}
-			}
-			
-			if (!foundDelayedValue) {
-				// If no delayed value found, use zero as the delayed input
-				delayedInput = 0.0f;
+			if (targetTime >= oldest) {
+				delayedInput = inputBuffer.sample(inputBuffer.ageAt(targetTime), i, mode);
 			}
 			
 			// Apply feedback formula: new output = delayed input + (feedback * previous output)
@@ -79,27 +54,18 @@ public:
 		
 		// Set output parameter
 		output = currentOutput;
-		
-		// Update last update time
-		lastUpdateTime = currentTime;
 	}
 	
 private:
-	// Structure to store timestamped data
-	struct TimeStampedData {
-		uint64_t timestamp;
-		vector<float> data;
-	};
-	
 	ofParameter<vector<float>> input;
 	ofParameter<vector<float>> delayMs;
 	ofParameter<float> feedback;
 	ofParameter<int> bufferMaxSize;
+	ofParameter<int> interpolation;
 	ofParameter<vector<float>> output;
 	
-	deque<TimeStampedData> inputBuffer;  // Buffer to store input values
+	dataRing inputBuffer;                // Timestamped input history
 	vector<float> currentOutput;         // Current output values
-	uint64_t lastUpdateTime;             // Last time update was called
 };
 
 #endif /* DATABUFFERFEEDBACKMS_H */
@@ -2,37 +2,80 @@
 #pragma once
 
 #include "ofxOceanodeNodeModel.h"
-#include <deque>
+#include "dataRing.h"
 
 class dataDelay : public ofxOceanodeNodeModel {
 public:
 	dataDelay() : ofxOceanodeNodeModel("Data Delay") {
-		description = "Delays the input vector by a number of frames. Output reflects the input as it was N frames ago.";
+		description = "Delays the input vector by a number of frames or milliseconds. Output reflects the input as it was N frames (or ms) ago.";
 	}
 
 	void setup() override {
 		addParameter(input.set("Input", {0}, {-FLT_MAX}, {FLT_MAX}));
 		addParameter(delayFrames.set("Frames", 0, 0, INT_MAX));
+		addParameter(delayMs.set("Delay ms", 0, 0, 60000));
+		addParameterDropdown(unit, "Unit", 0, {"Frames", "Ms"});
+		addParameterDropdown(interpolation, "Interp", 1, {"None", "Linear", "Cubic"});
 		addOutputParameter(output.set("Output", {0}, {-FLT_MAX}, {FLT_MAX}));
 
 		listener = delayFrames.newListener([this](int &i) {
-			store.resize(i);
+			if(unit == 0) store.reshape(i + 1, store.getWidth());
 		});
 	}
 
 	void update(ofEventArgs &a) override {
-		store.push_back(input.get());
-		if (!store.empty()) {
-			output = store[0];
-			store.pop_front();
+		const vector<float> &in = input.get();
+		double now = ofGetElapsedTimeMicros() / 1000.0;
+		store.reshape(historyFrames(), in.size());
+		store.push(in, now);
+
+		if(unit == 1) {
+			// Empty until the history reaches back far enough
+			double target = now - delayMs;
+			if(store.size() > 0 && store.timeAt(store.size() - 1) <= target) {
+				auto mode = static_cast<dataRing::Interpolation>(interpolation.get());
+				float age = store.ageAt(target);
+				outAux.resize(store.getWidth());
+				for(int i = 0; i < outAux.size(); i++) {
+					outAux[i] = store.sample(age, i, mode);
+				}
+			} else {
+				outAux.clear();
+			}
+			output = outAux;
+			return;
+		}
+
+		// Empty until N frames of history exist after a (re)start
+		if(delayFrames < store.size()) {
+			const float* f = store.frame(delayFrames);
+			outAux.assign(f, f + store.getWidth());
+		} else {
+			outAux.clear();
 		}
+		output = outAux;
 	}
 
 private:
+	// Ms mode keeps enough frames for the delay at the current frame rate,
+	// rounded up to a power of two so fps jitter doesn't reallocate
+	int historyFrames() const {
+		if(unit == 0) return delayFrames + 1;
+		float fps = std::max(ofGetFrameRate(), 1.0f);
+		int needed = (int)std::ceil(delayMs * fps / 1000.0f) + 4;
+		int frames = 4;
+		while(frames < needed) frames *= 2;
+		return frames;
+	}
+
 	ofParameter<vector<float>> input;
 	ofParameter<int>           delayFrames;
+	ofParameter<float>         delayMs;
+	ofParameter<int>           unit;
+	ofParameter<int>           interpolation;
 	ofParameter<vector<float>> output;
 
 	ofEventListener            listener;
-	std::deque<vector<float>>  store;
+	dataRing                   store;
+	vector<float>              outAux;
 };
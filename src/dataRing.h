@@ -0,0 +1,152 @@
+#ifndef DATARING_H
+#define DATARING_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Frame history for the data delay nodes: up to `capacity` frames of `width`
+// channels in one buffer, each with the time it was written. The buffer grows
+// geometrically as frames arrive, so a huge configured size only costs memory
+// once that much history exists. Once full, frames are written in place and
+// read by age (0 = newest), so steady-state updates never touch the heap.
+// Ages may be fractional, and ageAt() maps a time in ms to an age so channels
+// can be read at arbitrary ms delays.
+class dataRing {
+public:
+	enum Interpolation { None, Linear, Cubic };
+
+	// Reallocates only when the shape changes. The newest frames and the
+	// channels both shapes share are carried over; new channels start at 0.
+	void reshape(int frames, int channels) {
+		frames = std::max(frames, 1);
+		channels = std::max(channels, 0);
+		if(frames == capacity && channels == width) return;
+
+		int keep = std::min(count, frames);
+		int alloc = std::min(frames, std::max(keep, INITIAL_FRAMES));
+		std::vector<float> next((size_t)alloc * channels, 0.0f);
+		std::vector<double> nextTimes(alloc, 0.0);
+		int common = std::min(width, channels);
+		for(int age = 0; age < keep; age++) {
+			const float* src = frame(age);
+			int idx = keep - 1 - age;
+			std::copy(src, src + common, next.data() + (size_t)idx * channels);
+			nextTimes[idx] = timeAt(age);
+		}
+
+		data.swap(next);
+		times.swap(nextTimes);
+		capacity = frames;
+		allocated = alloc;
+		width = channels;
+		count = keep;
+		head = keep % capacity;
+	}
+
+	// Writes the newest frame, overwriting the oldest once full
+	void push(const std::vector<float>& v, double timeMs = 0.0) {
+		if(count == allocated && allocated < capacity) grow();
+		float* dst = data.data() + (size_t)head * width;
+		int n = std::min((int)v.size(), width);
+		std::copy(v.begin(), v.begin() + n, dst);
+		std::fill(dst + n, dst + width, 0.0f);
+		times[head] = timeMs;
+		head = (head + 1) % allocated;
+		count = std::min(count + 1, capacity);
+	}
+
+	// age must be < size()
+	const float* frame(int age) const {
+		return data.data() + (size_t)slot(age) * width;
+	}
+	double timeAt(int age) const {
+		return times[slot(age)];
+	}
+
+	// Fractional age of the history at timeMs, clamped to [0, size() - 1].
+	// Evenly spaced frames resolve with one guess; irregular timing falls
+	// back to a binary search over the timestamps.
+	float ageAt(double timeMs) const {
+		if(count < 2) return 0;
+		double newest = timeAt(0);
+		double oldest = timeAt(count - 1);
+		if(timeMs >= newest) return 0;
+		if(timeMs <= oldest) return count - 1;
+
+		int last = count - 2;
+		int guess = std::min(last, (int)((newest - timeMs) / (newest - oldest) * (count - 1)));
+		int age = -1;
+		for(int a = std::max(0, guess - 1); a <= std::min(last, guess + 1); a++) {
+			if(brackets(a, timeMs)) { age = a; break; }
+		}
+		if(age < 0) {
+			// Ages run backwards in time: find the first frame at or before timeMs
+			int lo = 1, hi = count - 1;
+			while(lo < hi) {
+				int mid = (lo + hi) / 2;
+				if(timeAt(mid) <= timeMs) hi = mid;
+				else lo = mid + 1;
+			}
+			age = lo - 1;
+		}
+
+		double t0 = timeAt(age), t1 = timeAt(age + 1);
+		return age + (t0 > t1 ? (float)((t0 - timeMs) / (t0 - t1)) : 0.0f);
+	}
+
+	// Channel value at a fractional age. None takes the newest frame that is
+	// not newer than the requested age; Cubic is Catmull-Rom.
+	float sample(float age, int channel, Interpolation interp) const {
+		if(count == 0 || channel < 0 || channel >= width) return 0;
+		age = std::max(0.0f, std::min(age, (float)(count - 1)));
+
+		if(interp == None) {
+			int i = std::min(count - 1, (int)std::ceil(age));
+			return frame(i)[channel];
+		}
+
+		int i = std::min((int)age, count - 1);
+		float t = age - i;
+		float p1 = frame(i)[channel];
+		float p2 = frame(std::min(i + 1, count - 1))[channel];
+		if(interp == Linear || t == 0) return p1 + (p2 - p1) * t;
+
+		float p0 = frame(std::max(i - 1, 0))[channel];
+		float p3 = frame(std::min(i + 2, count - 1))[channel];
+		return p1 + 0.5f * t * (p2 - p0 + t * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3 + t * (3.0f * (p1 - p2) + p3 - p0)));
+	}
+
+	int size() const { return count; }
+	int getWidth() const { return width; }
+	void clear() { count = 0; head = 0; }
+
+private:
+	static constexpr int INITIAL_FRAMES = 64;
+
+	std::vector<float>  data;
+	std::vector<double> times;
+	int capacity = 0;  // configured size in frames
+	int allocated = 0; // frames data/times hold, up to capacity
+	int width = 0;
+	int count = 0;
+	int head = 0; // slot the next frame is written to
+
+	int slot(int age) const {
+		int idx = head - 1 - age;
+		return idx < 0 ? idx + allocated : idx;
+	}
+	// Until the ring first fills, frames sit oldest-first from slot 0, so
+	// growing is a plain resize
+	void grow() {
+		allocated = (int)std::min<long long>(capacity, std::max<long long>(2LL * allocated, INITIAL_FRAMES));
+		data.resize((size_t)allocated * width, 0.0f);
+		times.resize(allocated, 0.0);
+		head = count;
+	}
+	bool brackets(int age, double timeMs) const {
+		return timeAt(age) >= timeMs && timeAt(age + 1) <= timeMs;
+	}
+};
+
+#endif /* DATARING_H */
@@ -1,5 +1,6 @@
 #pragma once
 #include "ofxOceanodeNodeModel.h"
+#include "timerService.h"
 #include <cmath>
 
 class debounce : public ofxOceanodeNodeModel {
@@ -22,40 +23,28 @@ public:
 		// estat inicial
 		currentStable = input.get();   // agafem el que hi hagi
 		candidate     = currentStable;
-		stableCounter = 0;
 
-		// listener per si canvia la mida de l'input
+		// cada valor nou esdevé candidat i arma un timer de frames; si no
+		// arriba cap altre valor abans que salti, el deixem passar
 		inputListener = input.newListener([this](vector<float> &v){
-			resizeInternal(v.size());
+			if(v.size() != currentStable.size()){
+				resizeInternal(v.size());
+			}
+			if(vectorsClose(v, candidate, tolerance)) return;
+
+			candidate = v;
+			if(requiredFrames <= 1){
+				timer.cancel(0);
+				promote();
+			} else {
+				// el frame actual compta com el primer
+				timer.atFrame(0, timerService::frameNum() + requiredFrames - 1, [this](uint64_t, uint64_t){
+					promote();
+				});
+			}
 		});
 	}
 
-	void update(ofEventArgs &e) override {
-		auto &in = input.get();
-
-		// assegurem mides
-		if(in.size() != currentStable.size()){
-			resizeInternal(in.size());
-		}
-
-		// 1) mirem si l'input és el mateix que el candidat dins la tolerància
-		if(vectorsClose(in, candidate, tolerance)){
-			stableCounter++;
-		} else {
-			// nou valor → esdevé candidat
-			candidate = in;
-			stableCounter = 1;
-		}
-
-		// 2) només quan porta prou frames igual → el deixem passar
-		if(stableCounter >= requiredFrames){
-			currentStable = candidate;
-		}
-
-		// 3) publiquem sempre l’últim valor estable
-		output = currentStable;
-	}
-
 private:
 	ofParameter<vector<float>> input;
 	ofParameter<int>           requiredFrames;
@@ -64,10 +53,17 @@ private:
 
 	vector<float> currentStable;   // el que efectivament veu el món
 	vector<float> candidate;       // el que està intentant entrar
-	int           stableCounter = 0;
+	nodeTimers    timer;           // un sol timer (clau 0) per al candidat
 
 	ofEventListener inputListener;
 
+	// només publiquem quan canvia el valor estable
+	void promote(){
+		if(candidate == currentStable) return;
+		currentStable = candidate;
+		output = currentStable;
+	}
+
 	void resizeInternal(size_t sz){
 		currentStable.resize(sz, 0.0f);
 		candidate.resize(sz, 0.0f);
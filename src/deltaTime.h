@@ -2,6 +2,7 @@
 #define deltaTime_h
 
 #include "ofxOceanodeNodeModel.h"
+#include "timerService.h"
 
 class deltaTime : public ofxOceanodeNodeModel {
 public:
@@ -40,7 +41,7 @@ public:
 private:
 	void processDeltaTime() {
 		const vector<float>& currentInput = input.get();
-		float currentTime = ofGetElapsedTimeMillis(); // Current time in milliseconds
+		double currentTime = timerService::nowMicros() / 1000.0; // Current time in milliseconds
 		bool ignoreZeroValues = ignoreZeros.get();
 		
 		// Resize state vectors if input size changed
@@ -89,8 +90,8 @@ private:
 	ofParameter<bool> ignoreZeros;
 	ofParameter<vector<float>> timeDelta;
 	
-	vector<float> lastTimeNonZero;     // Stores time of last non-zero value (used when ignoring zeros)
-	vector<float> lastValueChangeTime; // Stores time of last value change (used when not ignoring zeros)
+	vector<double> lastTimeNonZero;    // Stores time of last non-zero value (used when ignoring zeros)
+	vector<double> lastValueChangeTime; // Stores time of last value change (used when not ignoring zeros)
 	vector<float> lastValues;          // Stores last value for each index (for change detection)
 	vector<float> outputValues;        // Stores the calculated time deltas
 	
@@ -18,6 +18,12 @@
 #include <utility>
 #include <numeric>
 
+#if defined(_MSC_VER)
+#define FORMULA_RESTRICT __restrict
+#else
+#define FORMULA_RESTRICT __restrict__
+#endif
+
 class formula : public ofxOceanodeNodeModel {
 public:
 	formula() : ofxOceanodeNodeModel("Formula") {}
@@ -45,6 +51,8 @@ public:
 
 		// Formula (moved to inspector only)
 		addInspectorParameter(formulaString.set("Formula", "($1 + $2) / 2"));
+		// Compiled bytecode evaluation (off = legacy string-keyed RPN interpreter)
+		addInspectorParameter(compiledEval.set("Compiled Eval", true));
 
 		// Output
 		addOutputParameter(output.set("Output", {0}, {-FLT_MAX}, {FLT_MAX}));
@@ -149,6 +157,7 @@ private:
 	ofParameter<int> numInputs;
 	ofParameter<std::string> formulaString;
 	ofParameter<std::vector<float>> output;
+	ofParameter<bool> compiledEval;
 
 	customGuiRegion formulaEditorRegion;
 	mutable std::string formulaBuf;
@@ -165,6 +174,7 @@ private:
 	std::map<int, std::shared_ptr<ofxOceanodeParameter<std::vector<float>>>> inputParameters;
 	std::map<int, std::shared_ptr<ofParameter<std::vector<float>>>>          inputParamRefs;
 	std::map<int, ofEventListener>                                           inputListeners;
+	std::vector<const ofParameter<std::vector<float>>*>                      inputSlots; // dense view of inputParamRefs for the VM
 
 	static inline bool isConstantVector(const std::vector<float>& v, float eps = 1e-6f){
 		if(v.empty()) return true;
@@ -234,6 +244,676 @@ private:
 		return Value::vector(std::move(out));
 	}
 
+	// ===== Compiled program (bytecode over preallocated registers) =====
+	enum class Op : uint8_t {
+		PushConst, PushInput, PushN,
+		VecLit, Concat, Repeat, Indices, At, Len, Sort, PairDist,
+		Sum, Mean, Median, Rms, Std, Var, IdxMin, IdxMax, MinR, MaxR,
+		MinN, MaxN,
+		Sin, Cos, Tan, Asin, Acos, Atan, Sinh, Cosh, Tanh,
+		Exp, Log, Log10, Sqrt, Abs, Floor, Ceil, Round, Neg, Not,
+		Atan2, Pow, Add, Sub, Mul, Div, Mod,
+		Lt, Gt, Le, Ge, Eq, Ne, And, Or,
+		Clamp, Step, Smoothstep, If,
+		Fused,  // runs kernels[arg], consuming its numArgs stack operands
+		Arg     // kernel leaf: k-th stack operand of the fused op
+	};
+	struct Instr {
+		Op op;
+		int arg = 0;        // input slot, argc, kernel index or operand index
+		float value = 0.0f; // constant
+	};
+
+	// A maximal elementwise subtree, evaluated lane-block by lane-block in a
+	// single pass over the output instead of one temporary vector per operator.
+	struct Kernel {
+		std::vector<Instr> code;  // postfix; leaves are PushConst/PushN/PushInput/Arg
+		int numArgs  = 0;         // operands popped from the main stack
+		int depth    = 0;         // lane buffers needed
+		int condEnd  = -1;        // If-rooted kernels: last instruction of the condition
+	};
+	static constexpr size_t kLaneBlock = 256;
+
+	std::vector<Instr> program;
+	std::vector<Kernel> kernels;
+	std::vector<Value> regs;        // operand stack, sized to the program's max depth
+	std::vector<Value> fallbackRegs;// kernel operand stack when a kernel can't run fused
+	std::vector<float> scratch;     // reused by median / pairdist / fused output
+	std::vector<float> laneBuf;     // one kLaneBlock slice per kernel instruction
+	std::vector<const float*> lanePtr;
+
+	static inline const float* valueData(const Value& x){ return x.isVec ? x.v.data() : &x.f; }
+	static inline void setScalar(Value& a, float x){ a.isVec = false; a.f = x; }
+	static inline void makeVector(Value& a){
+		if(!a.isVec){ float x = a.f; a.v.assign(1, x); a.isVec = true; }
+	}
+	// Same semantics as Value::broadcast, but in place (keeps the register's capacity)
+	static inline void expandTo(Value& a, size_t n){
+		if(!a.isVec){ float x = a.f; a.v.assign(n, x); a.isVec = true; return; }
+		if(a.v.size() != n) a.v.resize(n, a.v.empty() ? 0.0f : a.v.back());
+	}
+	template<class F>
+	static inline void applyUnary(Value& a, F f){
+		if(!a.isVec){ a.f = f(a.f); return; }
+		for(float& x : a.v) x = f(x);
+	}
+	template<class F>
+	static inline void applyBinary(Value& a, const Value& b, F f){
+		const size_t n = std::max(a.size(), b.size());
+		if(n == 1){ setScalar(a, f(a.getScalar(), b.getScalar())); return; }
+		expandTo(a, n);
+		float* A = a.v.data();
+		if(!b.isVec){
+			const float y = b.f;
+			for(size_t i = 0; i < n; ++i) A[i] = f(A[i], y);
+		}else if(b.v.size() == n){
+			const float* B = b.v.data();
+			for(size_t i = 0; i < n; ++i) A[i] = f(A[i], B[i]);
+		}else{
+			for(size_t i = 0; i < n; ++i) A[i] = f(A[i], sampleAt(b, i));
+		}
+	}
+
+	// Single source of truth for elementwise semantics: the stack VM, the fused
+	// lane loops and the fallback path all instantiate these functors.
+	template<class V>
+	static inline bool dispatchUnary(Op op, V&& visit){
+		switch(op){
+		case Op::Sin:   visit([](float x){ return std::sin(x); }); return true;
+		case Op::Cos:   visit([](float x){ return std::cos(x); }); return true;
+		case Op::Tan:   visit([](float x){ return std::tan(x); }); return true;
+		case Op::Asin:  visit([](float x){ return std::asin(x); }); return true;
+		case Op::Acos:  visit([](float x){ return std::acos(x); }); return true;
+		case Op::Atan:  visit([](float x){ return std::atan(x); }); return true;
+		case Op::Sinh:  visit([](float x){ return std::sinh(x); }); return true;
+		case Op::Cosh:  visit([](float x){ return std::cosh(x); }); return true;
+		case Op::Tanh:  visit([](float x){ return std::tanh(x); }); return true;
+		case Op::Exp:   visit([](float x){ return std::exp(x); }); return true;
+		case Op::Log:   visit([](float x){ return std::log(x); }); return true;
+		case Op::Log10: visit([](float x){ return std::log10(x); }); return true;
+		case Op::Sqrt:  visit([](float x){ return std::sqrt(x); }); return true;
+		case Op::Abs:   visit([](float x){ return std::fabs(x); }); return true;
+		case Op::Floor: visit([](float x){ return std::floor(x); }); return true;
+		case Op::Ceil:  visit([](float x){ return std::ceil(x); }); return true;
+		case Op::Round: visit([](float x){ return std::round(x); }); return true;
+		case Op::Neg:   visit([](float x){ return -x; }); return true;
+		case Op::Not:   visit([](float x){ return x==0.0f?1.0f:0.0f; }); return true;
+		default: return false;
+		}
+	}
+	template<class V>
+	static inline bool dispatchBinary(Op op, V&& visit){
+		switch(op){
+		case Op::Atan2: visit([](float a,float b){ return std::atan2(a,b); }); return true;
+		case Op::Pow:   visit([](float x,float y){ return std::pow(x,y); }); return true;
+		case Op::Add:   visit([](float x,float y){ return x+y; }); return true;
+		case Op::Sub:   visit([](float x,float y){ return x-y; }); return true;
+		case Op::Mul:   visit([](float x,float y){ return x*y; }); return true;
+		case Op::Div:   visit([](float x,float y){ return x/y; }); return true;
+		case Op::Mod:   visit([](float x,float y){ return std::fmod(x,y); }); return true;
+		case Op::Lt:    visit([](float x,float y){ return x< y?1.0f:0.0f; }); return true;
+		case Op::Gt:    visit([](float x,float y){ return x> y?1.0f:0.0f; }); return true;
+		case Op::Le:    visit([](float x,float y){ return x<=y?1.0f:0.0f; }); return true;
+		case Op::Ge:    visit([](float x,float y){ return x>=y?1.0f:0.0f; }); return true;
+		case Op::Eq:    visit([](float x,float y){ return x==y?1.0f:0.0f; }); return true;
+		case Op::Ne:    visit([](float x,float y){ return x!=y?1.0f:0.0f; }); return true;
+		case Op::And:   visit([](float x,float y){ return (x!=0.0f && y!=0.0f)?1.0f:0.0f; }); return true;
+		case Op::Or:    visit([](float x,float y){ return (x!=0.0f || y!=0.0f)?1.0f:0.0f; }); return true;
+		case Op::Step:  visit([](float E,float X){ return X<E?0.0f:1.0f; }); return true;
+		case Op::MinN:  visit([](float a,float b){ return std::min(a,b); }); return true;
+		case Op::MaxN:  visit([](float a,float b){ return std::max(a,b); }); return true;
+		default: return false;
+		}
+	}
+	// Lane loops over one block; out never aliases a kernel operand (see runKernel)
+	template<class F>
+	static inline void laneMap(float* FORMULA_RESTRICT out, const float* a, size_t n, F f){
+		for(size_t j = 0; j < n; ++j) out[j] = f(a[j]);
+	}
+	template<class F>
+	static inline void laneMap(float* out, const float* a, const float* b, size_t n, F f){
+		if(out == a){ for(size_t j = 0; j < n; ++j) out[j] = f(out[j], b[j]); return; } // n-ary min/max fold
+		laneMapDistinct(out, a, b, n, f);
+	}
+	template<class F>
+	static inline void laneMapDistinct(float* FORMULA_RESTRICT out, const float* a, const float* b, size_t n, F f){
+		for(size_t j = 0; j < n; ++j) out[j] = f(a[j], b[j]);
+	}
+	static inline float smoothstepT(float num, float den){
+		float t = den==0? (num<0?0.0f:1.0f) : std::max(0.0f,std::min(1.0f,num/den));
+		return t*t*(3.0f-2.0f*t);
+	}
+
+	static bool isElementwise(Op op){
+		return dispatchUnary(op, [](auto){}) || dispatchBinary(op, [](auto){}) ||
+			   op == Op::Clamp || op == Op::Smoothstep;
+	}
+	static int operandCount(const Instr& in){
+		switch(in.op){
+		case Op::PushConst: case Op::PushInput: case Op::PushN: return 0;
+		case Op::VecLit: case Op::Concat: case Op::MinN: case Op::MaxN: return in.arg;
+		case Op::Repeat: case Op::At: case Op::PairDist: return 2;
+		case Op::Clamp: case Op::Smoothstep: case Op::If: return 3;
+		default: return dispatchBinary(in.op, [](auto){}) ? 2 : 1;
+		}
+	}
+
+	// Parses "$k" (as produced by addInputParameter) into a zero-based slot, or -1
+	static int inputSlotFromName(const std::string& id){
+		if(id.size() < 2 || id.size() > 10 || id[0] != '$' || id[1] == '0') return -1;
+		int k = 0;
+		for(size_t i = 1; i < id.size(); ++i){
+			if(!std::isdigit((unsigned char)id[i])) return -1;
+			k = k * 10 + (id[i] - '0');
+		}
+		return k - 1;
+	}
+
+	// Resolves identifiers to slots/opcodes and validates the stack once, so arity
+	// and underflow errors surface here instead of on every evaluation.
+	void compileProgram(const RPN& code){
+		program.clear();
+		kernels.clear();
+		int depth = 0, maxDepth = 0;
+		auto emit = [&](Op op, int pops, int arg = 0, float value = 0.0f){
+			if(depth < pops) throw std::runtime_error("Stack underflow");
+			depth += 1 - pops;
+			maxDepth = std::max(maxDepth, depth);
+			program.push_back(Instr{op, arg, value});
+		};
+		auto needArgs = [](int argc, int n, const char* msg){ if(argc != n) throw std::runtime_error(msg); };
+
+		static const std::map<std::string, Op> unaryFuncs = {
+			{"sin",Op::Sin},{"cos",Op::Cos},{"tan",Op::Tan},{"asin",Op::Asin},{"acos",Op::Acos},{"atan",Op::Atan},
+			{"sinh",Op::Sinh},{"cosh",Op::Cosh},{"tanh",Op::Tanh},{"exp",Op::Exp},{"log",Op::Log},{"log10",Op::Log10},
+			{"sqrt",Op::Sqrt},{"abs",Op::Abs},{"floor",Op::Floor},{"ceil",Op::Ceil},{"round",Op::Round}
+		};
+		static const std::map<std::string, Op> reducers = {
+			{"sum",Op::Sum},{"mean",Op::Mean},{"median",Op::Median},{"rms",Op::Rms},{"std",Op::Std},{"var",Op::Var},
+			{"idxmin",Op::IdxMin},{"idxmax",Op::IdxMax},{"min",Op::MinR},{"max",Op::MaxR}
+		};
+		static const std::map<std::string, Op> binaryOps = {
+			{"+",Op::Add},{"-",Op::Sub},{"*",Op::Mul},{"/",Op::Div},{"%",Op::Mod},{"^",Op::Pow},
+			{"<",Op::Lt},{">",Op::Gt},{"<=",Op::Le},{">=",Op::Ge},{"==",Op::Eq},{"!=",Op::Ne},{"&&",Op::And},{"||",Op::Or}
+		};
+
+		for(const auto& t : code){
+			if(t.type == Token::Number){ emit(Op::PushConst, 0, 0, t.value); continue; }
+
+			if(t.type == Token::Operator){
+				if(t.unary && t.text == "-"){ emit(Op::Neg, 1); continue; }
+				if(t.unary && t.text == "!"){ emit(Op::Not, 1); continue; }
+				auto it = binaryOps.find(t.text);
+				if(it == binaryOps.end()) throw std::runtime_error("Unknown operator: " + t.text);
+				emit(it->second, 2);
+				continue;
+			}
+
+			if(t.type != Token::Identifier) continue;
+			const std::string& id = t.text;
+			const int argc = (int)t.value;
+
+			// variables / constants
+			if(id == "pi" || id == "PI"){ emit(Op::PushConst, 0, 0, float(M_PI)); continue; }
+			if(id == "e"  || id == "E") { emit(Op::PushConst, 0, 0, float(M_E));  continue; }
+			if(id == "N"){ emit(Op::PushN, 0); continue; }
+			int slot = inputSlotFromName(id);
+			if(slot >= 0){ emit(Op::PushInput, 0, slot); continue; }
+
+			if(id == "__veclit"){ emit(Op::VecLit, argc, argc); continue; }
+
+			if(id == "len")    { needArgs(argc, 1, "len(v) expects 1 arg");     emit(Op::Len, 1); continue; }
+			if(id == "indices"){ needArgs(argc, 1, "indices(v) expects 1 arg"); emit(Op::Indices, 1); continue; }
+			if(id == "at")     { needArgs(argc, 2, "at(v,i) expects 2 args");   emit(Op::At, 2); continue; }
+			if(id == "vec" || id == "concat"){ emit(Op::Concat, argc, argc); continue; }
+			if(id == "repeat") { needArgs(argc, 2, "repeat(x,n) expects 2 args"); emit(Op::Repeat, 2); continue; }
+			if(id == "sort")   { needArgs(argc, 1, "sort(v) expects 1 arg");    emit(Op::Sort, 1); continue; }
+
+			auto red = reducers.find(id);
+			if(red != reducers.end()){
+				if(argc == 1){ emit(red->second, 1); continue; }
+				if((id == "min" || id == "max") && argc >= 2){ emit(id == "min" ? Op::MinN : Op::MaxN, argc, argc); continue; }
+				throw std::runtime_error(id + " expects 1 arg");
+			}
+
+			auto un = unaryFuncs.find(id);
+			if(un != unaryFuncs.end()){ emit(un->second, 1); continue; }
+
+			if(id == "atan2")     { needArgs(argc, 2, "atan2(y,x) needs 2");           emit(Op::Atan2, 2); continue; }
+			if(id == "pow")       { needArgs(argc, 2, "pow(a,b) needs 2");             emit(Op::Pow, 2); continue; }
+			if(id == "clamp")     { needArgs(argc, 3, "clamp(x,lo,hi) needs 3");       emit(Op::Clamp, 3); continue; }
+			if(id == "step")      { needArgs(argc, 2, "step(edge,x) needs 2");         emit(Op::Step, 2); continue; }
+			if(id == "smoothstep"){ needArgs(argc, 3, "smoothstep(e0,e1,x) needs 3");  emit(Op::Smoothstep, 3); continue; }
+			if(id == "if")        { needArgs(argc, 3, "if(cond,a,b) needs 3");         emit(Op::If, 3); continue; }
+			if(id == "pairdist")  { needArgs(argc, 2, "pairdist(x, y) expects 2 args"); emit(Op::PairDist, 2); continue; }
+
+			throw std::runtime_error("Unknown identifier: " + id);
+		}
+
+		if(depth != 1) throw std::runtime_error("Evaluation ended with bad stack size");
+		fuseProgram();
+
+		// Kernel operands are all live at once, so the fused program can run deeper
+		depth = maxDepth = 0;
+		for(const Instr& in : program){
+			depth += 1 - (in.op == Op::Fused ? kernels[in.arg].numArgs : operandCount(in));
+			maxDepth = std::max(maxDepth, depth);
+		}
+		regs.resize(maxDepth);
+	}
+
+	// Rewrites the program so every maximal elementwise subtree becomes one Fused op.
+	// Fusion stops at anything that is not elementwise (reductions, sort, at, concat...):
+	// those still run on the stack and feed the kernel as Arg operands. if() can only
+	// root a kernel, since its output length follows the condition rather than the
+	// longest operand.
+	void fuseProgram(){
+		struct Node { int instr; std::vector<int> kids; int parent = -1; };
+		std::vector<Node> nodes(program.size());
+		std::vector<int> st;
+		for(int i = 0; i < (int)program.size(); ++i){
+			nodes[i].instr = i;
+			int n = operandCount(program[i]);
+			nodes[i].kids.assign(st.end() - n, st.end());
+			st.resize(st.size() - n);
+			for(int k : nodes[i].kids) nodes[k].parent = i;
+			st.push_back(i);
+		}
+
+		auto fusible = [&](int i){ return isElementwise(program[i].op) || program[i].op == Op::If; };
+		auto joinsParent = [&](int i){
+			return isElementwise(program[i].op) && nodes[i].parent >= 0 && fusible(nodes[i].parent);
+		};
+		auto isLeafPush = [&](int i){
+			Op op = program[i].op;
+			return op == Op::PushConst || op == Op::PushN || op == Op::PushInput;
+		};
+
+		std::vector<Instr> out;
+		out.reserve(program.size());
+		std::function<void(int)> emitNode;
+		std::function<void(int, Kernel&, bool)> walk = [&](int i, Kernel& K, bool isRoot){
+			if(isLeafPush(i)){ K.code.push_back(program[i]); return; }
+			if(!isRoot && !joinsParent(i)){
+				emitNode(i);
+				K.code.push_back(Instr{Op::Arg, K.numArgs++});
+				return;
+			}
+			for(size_t k = 0; k < nodes[i].kids.size(); ++k){
+				walk(nodes[i].kids[k], K, false);
+			}
+			K.code.push_back(program[i]);
+		};
+		emitNode = [&](int i){
+			if(fusible(i) && !joinsParent(i)){
+				Kernel K;
+				walk(i, K, true);
+				foldConstants(K);
+				// kernel stack depth; an If root's condition is its first complete subtree,
+				// which ends at the last instruction (before the If itself) that leaves a
+				// single value on the stack: the branches always keep it above one
+				int d = 0;
+				const bool ifRoot = K.code.back().op == Op::If;
+				K.condEnd = -1;
+				for(int pc = 0; pc < (int)K.code.size(); ++pc){
+					const Instr& in = K.code[pc];
+					d += 1 - ((in.op == Op::Arg) ? 0 : operandCount(in));
+					K.depth = std::max(K.depth, d);
+					if(ifRoot && d == 1 && pc + 1 < (int)K.code.size()) K.condEnd = pc;
+				}
+				kernels.push_back(std::move(K));
+				out.push_back(Instr{Op::Fused, (int)kernels.size() - 1});
+				return;
+			}
+			for(int k : nodes[i].kids) emitNode(k);
+			out.push_back(program[i]);
+		};
+		emitNode((int)program.size() - 1);
+		program.swap(out);
+	}
+
+	// Collapses kernel subtrees whose leaves are all literals, so e.g. the
+	// smoothstep edge span is computed once instead of once per lane.
+	static void foldConstants(Kernel& K){
+		std::vector<Instr> out;
+		std::vector<Value> tmp;
+		for(const Instr& in : K.code){
+			const int argc = (in.op == Op::Arg) ? 0 : operandCount(in);
+			bool allConst = argc > 0 && (int)out.size() >= argc;
+			for(int k = 0; allConst && k < argc; ++k) allConst = out[out.size() - 1 - k].op == Op::PushConst;
+			if(!allConst){ out.push_back(in); continue; }
+
+			tmp.resize(argc);
+			for(int k = 0; k < argc; ++k) tmp[k] = Value::scalar(out[out.size() - argc + k].value);
+			size_t sp = argc;
+			applyElementwise(in, tmp, sp);
+			out.resize(out.size() - argc);
+			out.push_back(Instr{Op::PushConst, 0, tmp[0].f});
+		}
+		K.code.swap(out);
+	}
+
+	// Rebuilds the dense slot table after inputs are added or removed
+	void refreshInputSlots(){
+		inputSlots.assign(inputParamRefs.empty() ? 0 : inputParamRefs.rbegin()->first + 1, nullptr);
+		for(const auto& kv : inputParamRefs) inputSlots[kv.first] = kv.second.get();
+	}
+
+	const std::vector<float>& inputVector(int slot) const {
+		if(slot >= (int)inputSlots.size() || !inputSlots[slot])
+			throw std::runtime_error("Unknown identifier: $" + ofToString(slot + 1));
+		return inputSlots[slot]->get();
+	}
+	void loadInput(int slot, Value& r) const {
+		const auto& vec = inputVector(slot);
+		if(vec.size() <= 1) setScalar(r, vec.empty() ? 0.0f : vec[0]);
+		else { r.isVec = true; r.v.assign(vec.begin(), vec.end()); }
+	}
+
+	void reduceInPlace(Value& a, Op op){
+		const size_t n = a.size();
+		if(n == 0){ setScalar(a, 0.0f); return; }
+		const float* v = valueData(a);
+
+		switch(op){
+		case Op::Sum:  { double s=0; for(size_t i=0;i<n;i++) s+=v[i]; setScalar(a, (float)s); } break;
+		case Op::Mean: { double s=0; for(size_t i=0;i<n;i++) s+=v[i]; setScalar(a, (float)(s/n)); } break;
+		case Op::Median: {
+			scratch.assign(v, v + n);
+			std::nth_element(scratch.begin(), scratch.begin()+n/2, scratch.end());
+			float m = scratch[n/2];
+			if((n%2)==0){
+				std::nth_element(scratch.begin(), scratch.begin()+n/2-1, scratch.end());
+				m = (m+scratch[n/2-1])*0.5f;
+			}
+			setScalar(a, m);
+		} break;
+		case Op::Var:
+		case Op::Std: {
+			if(n < 2){ setScalar(a, 0.0f); break; }
+			double m=0; for(size_t i=0;i<n;i++) m+=v[i]; m/=n;
+			double s=0; for(size_t i=0;i<n;i++){ double d=v[i]-m; s+=d*d; }
+			float var = (float)(s/n);
+			setScalar(a, op == Op::Var ? var : std::sqrt(var));
+		} break;
+		case Op::Rms: { double s=0; for(size_t i=0;i<n;i++) s+=double(v[i])*v[i]; setScalar(a, (float)std::sqrt(s/n)); } break;
+		case Op::IdxMin: { size_t m=0; for(size_t i=1;i<n;i++) if(v[i]<v[m]) m=i; setScalar(a, (float)m); } break;
+		case Op::IdxMax: { size_t m=0; for(size_t i=1;i<n;i++) if(v[i]>v[m]) m=i; setScalar(a, (float)m); } break;
+		case Op::MinR: { float m=v[0]; for(size_t i=0;i<n;i++) m=std::min(m,v[i]); setScalar(a, m); } break;
+		case Op::MaxR: { float m=v[0]; for(size_t i=0;i<n;i++) m=std::max(m,v[i]); setScalar(a, m); } break;
+		default: break;
+		}
+	}
+
+	// Elementwise op on whole Values at the top of R (stack VM and kernel fallback)
+	static void applyElementwise(const Instr& in, std::vector<Value>& R, size_t& sp){
+		if(dispatchUnary(in.op, [&](auto f){ applyUnary(R[sp-1], f); })) return;
+		if(in.op == Op::MinN || in.op == Op::MaxN){
+			size_t base = sp - in.arg;
+			dispatchBinary(in.op, [&](auto f){ for(int k = 1; k < in.arg; ++k) applyBinary(R[base], R[base+k], f); });
+			sp = base + 1;
+			return;
+		}
+		if(dispatchBinary(in.op, [&](auto f){ applyBinary(R[sp-2], R[sp-1], f); })){ sp--; return; }
+
+		switch(in.op){
+		case Op::Clamp:
+			applyBinary(R[sp-3], R[sp-2], [](float a,float b){ return std::max(a,b); });
+			applyBinary(R[sp-3], R[sp-1], [](float a,float b){ return std::min(a,b); });
+			sp -= 2;
+			break;
+		case Op::Smoothstep: {
+			Value& e0 = R[sp-3];
+			Value& e1 = R[sp-2];
+			Value& x  = R[sp-1];
+			applyBinary(x,  e0, [](float X,float A){ return X-A; });
+			applyBinary(e1, e0, [](float B,float A){ return B-A; });
+			applyBinary(x,  e1, [](float num,float den){ return smoothstepT(num, den); });
+			std::swap(e0, x);
+			sp -= 2;
+		} break;
+		case Op::If: {
+			Value& cond  = R[sp-3];
+			Value& thenV = R[sp-2];
+			Value& elseV = R[sp-1];
+			// SCALAR condition: return branch AS-IS (no length alignment)
+			if(!cond.isVec) std::swap(cond, cond.f != 0.0f ? thenV : elseV);
+			else {
+				// VECTOR condition: per-index selection, length = cond.size()
+				for(size_t i = 0; i < cond.v.size(); ++i)
+					cond.v[i] = (cond.v[i] != 0.0f) ? sampleAt(thenV, i) : sampleAt(elseV, i);
+			}
+			sp -= 2;
+		} break;
+		default: break;
+		}
+	}
+
+	// Evaluates kernels[k] over the numArgs operands ending at regs[sp-1] and leaves
+	// the result in their first register. Lanes are processed kLaneBlock at a time
+	// with one tight loop per op, so temporaries stay in L1 and simple ops vectorise.
+	void runKernel(const Kernel& K, size_t& sp){
+		const size_t base = sp - K.numArgs;
+
+		// Length of every leaf; empty vectors and size-1 results keep the exact
+		// broadcasting/scalar rules of the stack VM, so those take the fallback.
+		auto leafLen = [&](const Instr& in)->size_t {
+			switch(in.op){
+			case Op::PushInput: { const auto& v = inputVector(in.arg); return v.size() <= 1 ? 1 : v.size(); }
+			case Op::Arg:       return regs[base + in.arg].size();
+			default:            return 1;
+			}
+		};
+		bool fused = true;
+		size_t n = 0, nCond = 0;
+		for(int i = 0; i < (int)K.code.size(); ++i){
+			const Instr& in = K.code[i];
+			if(operandCount(in) != 0 && in.op != Op::Arg) continue;
+			size_t len = leafLen(in);
+			if(len == 0) fused = false;
+			n = std::max(n, len);
+			if(i <= K.condEnd) nCond = std::max(nCond, len);
+		}
+		if(K.condEnd >= 0) n = nCond;
+		if(n < 2) fused = false;
+
+		if(!fused){
+			size_t fsp = 0;
+			fallbackRegs.resize(K.depth);
+			for(const Instr& in : K.code){
+				switch(in.op){
+				case Op::PushConst: setScalar(fallbackRegs[fsp++], in.value); break;
+				case Op::PushN:     setScalar(fallbackRegs[fsp++], currentN); break;
+				case Op::PushInput: loadInput(in.arg, fallbackRegs[fsp++]); break;
+				case Op::Arg:       fallbackRegs[fsp++] = regs[base + in.arg]; break;
+				default:            applyElementwise(in, fallbackRegs, fsp); break;
+				}
+			}
+			std::swap(regs[base], fallbackRegs[0]);
+			sp = base + 1;
+			return;
+		}
+
+		const size_t B = kLaneBlock;
+		// Every instruction owns its slice, so an op never writes over its own
+		// operands and the lane loops can take restrict pointers.
+		laneBuf.resize(K.code.size() * B);
+		lanePtr.resize(K.depth);
+		scratch.resize(n);
+
+		for(size_t off = 0; off < n; off += B){
+			const size_t cnt = std::min(B, n - off);
+			size_t d = 0;
+
+			// Scalars are splatted, full-length vectors are read in place,
+			// shorter vectors repeat their last element (clamp-to-last).
+			size_t pc = 0;
+			auto loadLeaf = [&](const float* data, size_t len){
+				float* buf = &laneBuf[pc * B];
+				if(len <= 1){
+					const float x = data[0];
+					for(size_t j = 0; j < cnt; ++j) buf[j] = x;
+					lanePtr[d] = buf;
+				}else if(off + cnt <= len){
+					lanePtr[d] = data + off;
+				}else{
+					for(size_t j = 0; j < cnt; ++j) buf[j] = data[std::min(off + j, len - 1)];
+					lanePtr[d] = buf;
+				}
+				d++;
+			};
+
+			for(pc = 0; pc < K.code.size(); ++pc){
+				const Instr& in = K.code[pc];
+				const bool last = (pc + 1 == K.code.size());
+				switch(in.op){
+				case Op::PushConst: loadLeaf(&in.value, 1); continue;
+				case Op::PushN:     loadLeaf(&currentN, 1); continue;
+				case Op::PushInput: {
+					// an empty input reads as scalar 0, like loadInput()
+					static const float zero = 0.0f;
+					const auto& v = inputVector(in.arg);
+					if(v.empty()) loadLeaf(&zero, 1); else loadLeaf(v.data(), v.size());
+				} continue;
+				case Op::Arg:       { const Value& a = regs[base + in.arg]; loadLeaf(valueData(a), a.size()); } continue;
+				default: break;
+				}
+
+				const size_t argc = operandCount(in);
+				const size_t dst  = d - argc;
+				float* out = last ? &scratch[off] : &laneBuf[pc * B];
+				const float* a = lanePtr[dst];
+
+				if(dispatchUnary(in.op, [&](auto f){ laneMap(out, a, cnt, f); })){}
+				else if(in.op == Op::MinN || in.op == Op::MaxN){
+					dispatchBinary(in.op, [&](auto f){
+						laneMap(out, a, lanePtr[dst + 1], cnt, f);
+						for(size_t k = 2; k < argc; ++k) laneMap(out, out, lanePtr[dst + k], cnt, f);
+					});
+				}
+				else if(dispatchBinary(in.op, [&](auto f){ laneMap(out, a, lanePtr[dst + 1], cnt, f); })){}
+				else if(in.op == Op::Clamp){
+					const float* lo = lanePtr[dst + 1];
+					const float* hi = lanePtr[dst + 2];
+					for(size_t j = 0; j < cnt; ++j) out[j] = std::min(std::max(a[j], lo[j]), hi[j]);
+				}
+				else if(in.op == Op::Smoothstep){
+					const float* e1 = lanePtr[dst + 1];
+					const float* x  = lanePtr[dst + 2];
+					for(size_t j = 0; j < cnt; ++j) out[j] = smoothstepT(x[j] - a[j], e1[j] - a[j]);
+				}
+				else if(in.op == Op::If){
+					const float* t = lanePtr[dst + 1];
+					const float* e = lanePtr[dst + 2];
+					for(size_t j = 0; j < cnt; ++j) out[j] = (a[j] != 0.0f) ? t[j] : e[j];
+				}
+				lanePtr[dst] = out;
+				d = dst + 1;
+			}
+		}
+
+		Value& r = regs[base];
+		r.isVec = true;
+		r.v.swap(scratch);
+		sp = base + 1;
+	}
+
+	// Runs the compiled program; result lives in regs[0] until the next call
+	const Value& execProgram(size_t N){
+		size_t sp = 0;
+		currentN = float(N);
+		auto asInt = [](float x){ return (int)std::floor(x+1e-6f); };
+
+		for(const Instr& in : program){
+			switch(in.op){
+			case Op::PushConst: setScalar(regs[sp++], in.value); break;
+			case Op::PushN:     setScalar(regs[sp++], currentN); break;
+			case Op::PushInput: loadInput(in.arg, regs[sp++]); break;
+			case Op::Fused:     runKernel(kernels[in.arg], sp); break;
+
+			case Op::VecLit: {
+				size_t base = sp - in.arg;
+				Value& d = regs[base];
+				float first = in.arg > 0 ? d.getScalar() : 0.0f;
+				d.isVec = true;
+				d.v.resize(in.arg);
+				if(in.arg > 0) d.v[0] = first;
+				for(int k = 1; k < in.arg; ++k) d.v[k] = regs[base + k].getScalar();
+				sp = base + 1;
+			} break;
+			case Op::Concat: {
+				size_t base = sp - in.arg;
+				Value& d = regs[base];
+				if(in.arg == 0){ d.isVec = true; d.v.clear(); }
+				else makeVector(d);
+				for(int k = 1; k < in.arg; ++k){
+					const Value& s = regs[base + k];
+					if(s.isVec) d.v.insert(d.v.end(), s.v.begin(), s.v.end()); else d.v.push_back(s.f);
+				}
+				sp = base + 1;
+			} break;
+			case Op::Repeat: {
+				Value& x = regs[sp-2];
+				int n = std::max(0, asInt(regs[sp-1].getScalar()));
+				float xs = x.getScalar();
+				x.isVec = true; x.v.assign(n, xs);
+				sp--;
+			} break;
+			case Op::Indices: {
+				Value& a = regs[sp-1];
+				size_t n = a.size();
+				a.isVec = true; a.v.resize(n);
+				for(size_t i = 0; i < n; ++i) a.v[i] = (float)i;
+			} break;
+			case Op::At: {
+				Value& vVal = regs[sp-2];
+				Value& iVal = regs[sp-1];
+				if(!iVal.isVec) setScalar(vVal, vVal.atClamped(asInt(iVal.f)));
+				else {
+					for(float& ii : iVal.v) ii = vVal.atClamped(asInt(ii));
+					std::swap(vVal, iVal);
+				}
+				sp--;
+			} break;
+			case Op::Len:  { Value& a = regs[sp-1]; setScalar(a, (float)a.size()); } break;
+			case Op::Sort: { Value& a = regs[sp-1]; makeVector(a); std::sort(a.v.begin(), a.v.end()); } break;
+			case Op::PairDist: {
+				const Value& vx = regs[sp-2];
+				const Value& vy = regs[sp-1];
+				const float* x = valueData(vx);
+				const float* y = valueData(vy);
+				size_t n = std::min(vx.size(), vy.size());
+				scratch.clear();
+				if(n >= 2){
+					scratch.reserve(n * (n - 1) / 2);
+					for(size_t i = 0; i + 1 < n; ++i){
+						float xi = x[i], yi = y[i];
+						for(size_t j = i + 1; j < n; ++j){
+							float dx = xi - x[j];
+							float dy = yi - y[j];
+							scratch.push_back(std::sqrt(dx*dx + dy*dy));
+						}
+					}
+				}
+				Value& d = regs[sp-2];
+				d.isVec = true; d.v.swap(scratch);
+				sp--;
+			} break;
+
+			case Op::Sum: case Op::Mean: case Op::Median: case Op::Rms: case Op::Std: case Op::Var:
+			case Op::IdxMin: case Op::IdxMax: case Op::MinR: case Op::MaxR:
+				reduceInPlace(regs[sp-1], in.op);
+				break;
+
+			default:
+				applyElementwise(in, regs, sp);
+				break;
+			}
+		}
+		return regs[0];
+	}
+	float currentN = 1.0f;
+
 	// ===== Listeners / inputs =====
 	void onFormulaParamChanged(std::string &s){
 		if(s != formulaBuf) formulaBuf = s;
@@ -262,6 +942,7 @@ private:
 		inputParameters[index] = oceaParam;
 
 		inputListeners[index] = paramRef->newListener([this](std::vector<float>&){ calculate(); });
+		refreshInputSlots();
 	}
 
 	void removeInputParameter(int index) {
@@ -270,6 +951,7 @@ private:
 		removeParameter(name);
 		inputParameters.erase(index);
 		inputParamRefs.erase(index);
+		refreshInputSlots();
 	}
 
 	// ===== Public evaluation =====
@@ -285,6 +967,31 @@ private:
 			N = std::max(N, kv.second->get().size());
 		}
 
+		try{
+			if(compiledEval.get()){
+				const Value& res = execProgram(N);
+#ifdef FORMULA_VERIFY_COMPILED
+				verifyCompiled(res, N);
+#endif
+				output = toOutput(res);
+			}else{
+				output = toOutput(evalLegacy(N));
+			}
+		}
+		catch(const std::exception& e){
+			ofLogError("Formula") << "Eval error: " << e.what();
+			output = {0.0f};
+		}
+	}
+
+	// Vector results as-is (empty -> [0]), scalars as size 1
+	static std::vector<float> toOutput(const Value& res){
+		if(res.isVec) return res.v.empty() ? std::vector<float>{0.0f} : res.v;
+		return std::vector<float>{ res.f };
+	}
+
+	// Legacy string-keyed interpreter over the current inputs; throws on eval errors
+	Value evalLegacy(size_t N){
 		// Build evaluation environment with full vectors/scalars
 		Env env;
 		for(const auto& kv : inputParamRefs){
@@ -301,22 +1008,27 @@ private:
 		env["e"]  = Value::scalar(float(M_E));  env["E"]  = env["e"];
 		env["N"]  = Value::scalar(float(N));    // optional helper
 
-		try{
-			Value res = evalRPN(rpn, env);
+		return evalRPN(rpn, env);
+	}
 
-			if(res.isVec){
-				// Return the vector result as-is (if empty, emit [0])
-				output = res.v.empty() ? std::vector<float>{0.0f} : res.v;
-			}else{
-				// Scalar result -> emit scalar (size 1)
-				output = std::vector<float>{ res.f };
-			}
-		}
+#ifdef FORMULA_VERIFY_COMPILED
+	// Build with FORMULA_VERIFY_COMPILED to check every compiled evaluation
+	// against the legacy interpreter (lengths and values, NaN == NaN)
+	void verifyCompiled(const Value& compiled, size_t N){
+		std::vector<float> a = toOutput(compiled), b;
+		try{ b = toOutput(evalLegacy(N)); }
 		catch(const std::exception& e){
-			ofLogError("Formula") << "Eval error: " << e.what();
-			output = {0.0f};
+			ofLogError("Formula") << "Parity: compiled ran but legacy threw: " << e.what();
+			return;
+		}
+		bool same = a.size() == b.size();
+		for(size_t i = 0; same && i < a.size(); ++i) same = a[i] == b[i] || (std::isnan(a[i]) && std::isnan(b[i]));
+		if(!same){
+			ofLogError("Formula") << "Parity: compiled and legacy differ for \"" << formulaString.get()
+			                      << "\" (" << a.size() << " vs " << b.size() << " values)";
 		}
 	}
+#endif
 
 
 	// ===== Compiler pipeline =====
@@ -324,6 +1036,7 @@ private:
 		lastError.clear();
 		formulaValid = false;
 		rpn.clear();
+		program.clear();
 
 		std::string src = formulaString.get();
 		if(src.empty()) {
@@ -335,6 +1048,7 @@ private:
 		try {
 			auto tokens = tokenize(src);
 			rpn = shuntingYard(tokens);
+			compileProgram(rpn);
 			formulaValid = true;
 		} catch(const std::exception& e) {
 			lastError = e.what();
@@ -2,6 +2,7 @@
 #define gateDuration_h
 
 #include "ofxOceanodeNodeModel.h"
+#include "timerService.h"
 
 class gateDuration : public ofxOceanodeNodeModel {
 public:
@@ -17,7 +18,7 @@ public:
 		
 		// Initialize state tracking variables
 		lastGateValues.clear();
-		gateEndTimes.clear();
+		timers.cancelAll();
 		
 		// Register listener for gate input changes
 		listener = gateInput.newListener([this](vector<float> &gates){
@@ -26,32 +27,15 @@ public:
 	}
 	
 	void update(ofEventArgs &e) override {
-		// Get current time
-		float currentTime = ofGetElapsedTimef();
-		
-		// Update output gates based on timing
-		vector<float> currentOutput = gateOutput.get();
-		bool outputChanged = false;
-		
-		// Make sure the output vector matches the input size
-		if (currentOutput.size() != gateInput->size()) {
+		// Gate-offs are handled by the timers, which only collect them here
+		// so that gates expiring in the same frame produce a single output
+		if (!expired.empty() || gateOutput->size() != gateInput->size()) {
+			vector<float> currentOutput = gateOutput.get();
 			currentOutput.resize(gateInput->size(), 0.0f);
-			outputChanged = true;
-		}
-		
-		// Update gates based on timers
-		for (size_t i = 0; i < gateInput->size(); i++) {
-			// If the gate is currently active, check if it should turn off
-			if (currentOutput[i] > 0.5f && gateEndTimes[i] <= currentTime) {
-				currentOutput[i] = 0.0f;
-				outputChanged = true;
+			for (size_t i : expired) {
+				if (i < currentOutput.size()) currentOutput[i] = 0.0f;
 			}
-			// If the gate just turned on due to a rising edge (handled in processGateChanges),
-			// it will already have the correct endTime and be set to 1
-		}
-		
-		// Update output if needed
-		if (outputChanged) {
+			expired.clear();
 			gateOutput = currentOutput;
 		}
 	}
@@ -65,11 +49,11 @@ private:
 		// Initialize or resize state vectors if needed
 		if (lastGateValues.size() != gates.size()) {
 			lastGateValues.resize(gates.size(), 0.0f);
-			gateEndTimes.resize(gates.size(), 0.0f);
+			timers.cancelFrom(gates.size());
 		}
 		
 		// Get current time
-		float currentTime = ofGetElapsedTimef();
+		uint64_t currentTime = timerService::nowMicros();
 		
 		// Prepare output vector
 		vector<float> currentOutput = gateOutput.get();
@@ -95,8 +79,12 @@ private:
 				// Set the gate on
 				currentOutput[i] = 1.0f;
 				
-				// Calculate when to turn it off (current time + duration in seconds)
-				gateEndTimes[i] = currentTime + (duration / 1000.0f);
+				// Schedule the gate-off (current time + duration); a new edge re-arms it
+				// and overrides a gate-off that fired earlier this frame
+				expired.erase(std::remove(expired.begin(), expired.end(), i), expired.end());
+				timers.atTime(i, currentTime + uint64_t(std::max(0.0f, duration) * 1000.0f), [this, i](uint64_t, uint64_t) {
+					expired.push_back(i);
+				});
 				
 				outputChanged = true;
 			}
@@ -116,7 +104,8 @@ private:
 	ofParameter<vector<float>> gateOutput;
 	
 	vector<float> lastGateValues;  // For detecting transitions
-	vector<float> gateEndTimes;    // Time when each gate should turn off
+	nodeTimers timers;             // Pending gate-off per index
+	vector<size_t> expired;        // Indices whose gate-off fired since the last update
 	
 	ofEventListener listener;
 };
@@ -419,6 +419,64 @@ public:
 		}
 	}
 	
+	// Lookahead events — gates live in primary clip space, so each clip pass
+	// maps them through its own start. One on/off pair per gate region.
+	void collectEvents(double beatFrom, double beatTo, std::vector<transportEvent>& out) override {
+		double cs0 = getClipStartAt(0);
+		scheduledOpenGates.resize(gateLanes.size(), 0);
+		forEachClipPass(beatFrom, beatTo, [&](double base, double limit) {
+			for(int lane = 0; lane < numLanes.get() && lane < gateLanes.size(); lane++) {
+				for(const auto& g : gateLanes[lane]) {
+					double on  = std::max(base + (g.start - cs0), base);
+					double off = std::min(base + (g.end() - cs0), limit);
+					if(on >= off) continue;
+					if(on >= beatFrom && on < beatTo) {
+						transportEvent e;
+						e.beat = on; e.type = transportEvent::GateOn;
+						e.index = lane; e.value = 1.f;
+						out.push_back(e);
+						scheduledOpenGates[lane]++;
+					}
+					if(off >= beatFrom && off < beatTo && scheduledOpenGates[lane] > 0) {
+						transportEvent e;
+						e.beat = off; e.type = transportEvent::GateOff;
+						e.index = lane; e.value = 0.f;
+						out.push_back(e);
+						scheduledOpenGates[lane]--;
+					}
+				}
+			}
+		});
+	}
+
+	void flushEvents(double beat, std::vector<transportEvent>& out) override {
+		for(int lane = 0; lane < scheduledOpenGates.size(); lane++) {
+			for(int i = 0; i < scheduledOpenGates[lane]; i++) {
+				transportEvent e;
+				e.beat = beat; e.type = transportEvent::GateOff;
+				e.index = lane; e.value = 0.f;
+				out.push_back(e);
+			}
+		}
+		std::fill(scheduledOpenGates.begin(), scheduledOpenGates.end(), 0);
+	}
+
+	// Block rendering — one channel per lane, 1 while any gate is open
+	int getRenderChannelCount() const override { return numLanes.get(); }
+
+	bool renderBlock(int channel, double beatFrom, double beatTo, int numSamples, float* out) override {
+		if(channel < 0 || channel >= numLanes.get() || numSamples <= 0) return false;
+		std::fill(out, out + numSamples, 0.0f);
+		if(channel >= gateLanes.size()) return true;
+
+		double step = std::max(0.0, beatTo - beatFrom) / numSamples;
+		double cs0  = getClipStartAt(0); // gates are in primary clip space
+		buildStepLane(gateLanes[channel], [](const GateRegion&) { return 1.0f; }, renderSteps);
+		forEachClipRun(beatFrom, step, numSamples, [&](int i0, int i1, double base) {
+			renderStepLane(renderSteps, cs0 + (beatFrom - base) + i0 * step, step, i1 - i0, out + i0);
+		});
+		return true;
+	}
 
 	// Clip window virtuals
 	bool   hasClipWindow()        const override { return true; }
@@ -572,6 +630,8 @@ private:
 	std::vector<std::string> timelineOptions;
 
 	std::vector<bool> lastActiveState;  // One per lane
+	std::vector<int> scheduledOpenGates;  // Gate-ons delivered by collectEvents awaiting their off, per lane
+	std::vector<std::pair<double, float>> renderSteps;  // renderBlock scratch
 	ofEventListeners listeners;
 	
 	// Drag state for creating gates
@@ -55,6 +55,7 @@ void globalSnapshots::setup(std::string additionalInfo) {
 	matrixCols.set("Cols", 8, 1, 8);
 	buttonSize.set("Button Size", 28.0f, 15.0f, 600.0f);
 	showSnapshotNames.set("Show Names", true);
+	binaryBank.set("Binary Bank", false);
 	includeMacroParams.set("Include Macro Params", false);
 	interpolationMs.set("Interpolation Ms", 0.0f, 0.0f, 60000.0f);
 	biPow.set("BiPow", 0.0f, -1.0f, 1.0f);
@@ -66,6 +67,7 @@ void globalSnapshots::setup(std::string additionalInfo) {
 	addInspectorParameter(matrixCols);
 	addInspectorParameter(buttonSize);
 	addInspectorParameter(showSnapshotNames);
+	addInspectorParameter(binaryBank);
 
 	addInspectorParameter(addSnapshotButton.set("Add Snapshot"));
 	addSnapshotListener = addSnapshotButton.newListener([this](){
@@ -267,8 +269,8 @@ void globalSnapshots::loadSnapshot(int slot) {
 		return;
 	}
 	
-	auto it = snapshots.find(slot);
-	if(it == snapshots.end()) return;
+	SnapshotData* snap = getDecodedSnapshot(slot);
+	if(!snap) return;
 
 	int loadedCount = 0;
 	for(auto *node : globalContainer->getAllModules()) {
@@ -287,8 +289,8 @@ void globalSnapshots::loadSnapshot(int slot) {
 			if(!oParam) continue;
 
 			std::string key = grpName + "/" + p.getName();
-			auto pit = it->second.paramValues.find(key);
-			if(pit == it->second.paramValues.end()) continue;
+			auto pit = snap->paramValues.find(key);
+			if(pit == snap->paramValues.end()) continue;
 
 			if(isParameterExcluded(key, oParam)) {
 				continue;
@@ -654,12 +656,89 @@ void globalSnapshots::macroLoad(ofJson &json, string path) {
 	loadSnapshotsFromFile();
 }
 
+std::string globalSnapshots::getSnapshotsBankPath() {
+	std::string filePath = getSnapshotsFilePath();
+	return filePath.substr(0, filePath.size() - 5) + ".bin"; // globalSnapshots.json -> .bin
+}
+
+globalSnapshots::SnapshotData* globalSnapshots::getDecodedSnapshot(int slot) {
+	auto it = snapshots.find(slot);
+	if(it == snapshots.end()) return nullptr;
+
+	SnapshotData &data = it->second;
+	if(data.pending) {
+		// Decode aside so a failed or partial decode leaves the slot pending
+		decltype(data.paramValues) decoded;
+		bool ok = bank.isOpen() && bank.decodeSlot(slot, [&decoded](const std::string &key, const std::string &type, ofJson &&value){
+			ParameterSnapshot ps;
+			ps.type = type;
+			ps.value = std::move(value);
+			decoded[key] = std::move(ps);
+		});
+		if(!ok) {
+			ofLogError("globalSnapshots") << "Failed to decode snapshot " << slot << " from bank";
+			return nullptr;
+		}
+		data.paramValues = std::move(decoded);
+		data.pending = false;
+	}
+	return &data;
+}
+
+bool globalSnapshots::decodePendingSnapshots() {
+	bool allDecoded = true;
+	for(auto &pair : snapshots) {
+		if(pair.second.pending && !getDecodedSnapshot(pair.first)) allDecoded = false;
+	}
+	// Slots that failed still need the mapping
+	if(allDecoded) bank.close();
+	return allDecoded;
+}
+
 void globalSnapshots::saveSnapshotsToFile() {
+	// Everything must be in memory before the mapped file is replaced. A slot
+	// that can't be decoded would be written back empty, so keep the old bank
+	// until it is overwritten or deleted.
+	if(!decodePendingSnapshots()) {
+		ofLogError("globalSnapshots") << "Not saving: some snapshots could not be decoded from " << getSnapshotsBankPath()
+									  << "; store or delete them first";
+		return;
+	}
+
+	std::string filePath = getSnapshotsFilePath();
+	std::string bankPath = getSnapshotsBankPath();
+
 	if(snapshots.empty() && manualExcludes.empty()) {
-		std::string filePath = getSnapshotsFilePath();
 		if(ofFile::doesFileExist(filePath)) {
 			ofFile::removeFile(filePath);
 		}
+		if(ofFile::doesFileExist(bankPath)) {
+			ofFile::removeFile(bankPath);
+		}
+		return;
+	}
+
+	// Only one format is kept on disk so load never sees a stale copy
+	if(binaryBank) {
+		globalSnapshotsBank writer;
+		for(const auto& pair : snapshots) {
+			writer.beginSlot(pair.first, pair.second.name);
+			for(const auto& paramPair : pair.second.paramValues) {
+				writer.addValue(paramPair.first, paramPair.second.type, paramPair.second.value);
+			}
+		}
+		for(const auto &k : manualExcludes) {
+			writer.addExcluded(k);
+		}
+
+		if(writer.save(bankPath)) {
+			if(ofFile::doesFileExist(filePath)) {
+				ofFile::removeFile(filePath);
+			}
+			ofLogNotice("globalSnapshots") << "Saved snapshots to: " << bankPath;
+		} else {
+			ofLogError("globalSnapshots") << "Failed to save snapshots to: " << bankPath;
+		}
 		return;
 	}
 	
@@ -686,8 +765,10 @@ void globalSnapshots::saveSnapshotsToFile() {
 	}
 	json["_excluded"] = excludedJson;
 	
-	std::string filePath = getSnapshotsFilePath();
 	if(ofSavePrettyJson(filePath, json)) {
+		if(ofFile::doesFileExist(bankPath)) {
+			ofFile::removeFile(bankPath);
+		}
 		ofLogNotice("globalSnapshots") << "Saved snapshots to: " << filePath;
 	} else {
 		ofLogError("globalSnapshots") << "Failed to save snapshots to: " << filePath;
@@ -696,12 +777,49 @@ void globalSnapshots::saveSnapshotsToFile() {
 
 void globalSnapshots::loadSnapshotsFromFile() {
 	std::string filePath = getSnapshotsFilePath();
-	
-	if(!ofFile::doesFileExist(filePath)) {
+	std::string bankPath = getSnapshotsBankPath();
+
+	// Prefer the configured format, but import whichever one exists
+	bool hasJson = ofFile::doesFileExist(filePath);
+	bool hasBank = ofFile::doesFileExist(bankPath);
+
+	if(!hasJson && !hasBank) {
 		ofLogVerbose("globalSnapshots") << "No snapshots file found at: " << filePath;
 		return;
 	}
-	
+
+	if(hasBank && (binaryBank || !hasJson)) {
+		if(loadSnapshotsFromBank(bankPath) || !hasJson) return;
+	}
+	loadSnapshotsFromJson(filePath);
+}
+
+bool globalSnapshots::loadSnapshotsFromBank(const std::string& filePath) {
+	snapshots.clear();
+	manualExcludes.clear();
+
+	if(!bank.open(filePath)) {
+		return false;
+	}
+
+	// Only names are read here; parameter values stay in the mapping until recalled
+	for(int slot : bank.getSlots()) {
+		SnapshotData &snapshotData = snapshots[slot];
+		snapshotData.name = bank.getSlotName(slot);
+		snapshotData.pending = true;
+	}
+	for(auto &k : bank.getExcluded()) {
+		manualExcludes.insert(k);
+	}
+
+	ofLogNotice("globalSnapshots") << "Loaded " << snapshots.size() << " snapshots from: " << filePath
+								   << " and " << manualExcludes.size() << " excluded params";
+	return true;
+}
+
+bool globalSnapshots::loadSnapshotsFromJson(const std::string& filePath) {
+	bank.close();
+
 	try {
 		ofJson json = ofLoadJson(filePath);
 		snapshots.clear();
@@ -744,24 +862,28 @@ void globalSnapshots::loadSnapshotsFromFile() {
 		
 		ofLogNotice("globalSnapshots") << "Loaded " << snapshots.size() << " snapshots from: " << filePath
 									   << " and " << manualExcludes.size() << " excluded params";
+		return true;
 		
 	} catch(const std::exception& e) {
 		ofLogError("globalSnapshots") << "Error loading snapshots: " << e.what();
 		snapshots.clear();
 		manualExcludes.clear();
+		return false;
 	}
 }
 
 void globalSnapshots::startInterpolation(int targetSlot) {
 	if (!globalContainer) return;
 	
-	auto it = snapshots.find(targetSlot);
-	if(it == snapshots.end()) return;
+	SnapshotData* snap = getDecodedSnapshot(targetSlot);
+	if(!snap) return;
 	
-	interpolationStartValues.clear();
-	interpolationActiveKeys.clear();
+	interpolationTracks.clear();
+	interpolationFrom.clear();
+	interpolationTo.clear();
+	interpolationStringTargets.clear();
 
-	auto &targetSnap = it->second.paramValues;
+	auto &targetSnap = snap->paramValues;
 	
 	// Use current BiPow as default; the old per-snapshot BiPow feature is removed
 	// since own node parameters are no longer stored in snapshots (they caused
@@ -811,90 +933,157 @@ void globalSnapshots::startInterpolation(int targetSlot) {
 				continue; // Don't add to interpolation
 			}
 
-			ParameterSnapshot ps;
-			ps.type = oParam->valueType();
+			InterpolationTrack track;
+			track.key   = key;
+			track.type  = oParam->valueType();
+
+			// Decode current and target values once into typed float spans
+			std::vector<float> from, to;
+			const ofJson &tgtJson = tgtIt->second.value;
 
 			try {
 				bool differs = false;
 
-				if(ps.type == typeid(float).name()) {
-					float cur = oParam->cast<float>().getParameter().get();
-					float tgt = tgtIt->second.value.get<float>();
-					ps.value = cur;
-					if(!floatsEqual(cur, tgt)) differs = true;
+				if(track.type == typeid(float).name()) {
+					track.kind = InterpolationKind::Float;
+					from = { oParam->cast<float>().getParameter().get() };
+					to   = { tgtJson.get<float>() };
+					differs = !floatsEqual(from[0], to[0]);
 				}
-				else if(ps.type == typeid(int).name()) {
+				else if(track.type == typeid(int).name()) {
+					track.kind = InterpolationKind::Int;
 					int cur = oParam->cast<int>().getParameter().get();
-					int tgt = (int)std::round(tgtIt->second.value.get<float>());
-					ps.value = (float)cur;
-					if(cur != tgt) differs = true;
+					from = { (float)cur };
+					to   = { tgtJson.get<float>() };
+					differs = cur != (int)std::round(to[0]);
 				}
-				else if(ps.type == typeid(std::vector<float>).name()) {
-					auto cur = oParam->cast<std::vector<float>>().getParameter().get();
-					auto tgt = tgtIt->second.value.get<std::vector<float>>();
-					ps.value = cur;
-					if(!floatVectorsEqual(cur, tgt)) differs = true;
+				else if(track.type == typeid(std::vector<float>).name()) {
+					track.kind = InterpolationKind::FloatVector;
+					from = oParam->cast<std::vector<float>>().getParameter().get();
+					to   = tgtJson.get<std::vector<float>>();
+					differs = !floatVectorsEqual(from, to);
 				}
-				else if(ps.type == typeid(std::vector<int>).name()) {
-					auto curI = oParam->cast<std::vector<int>>().getParameter().get();
-					std::vector<float> curF(curI.begin(), curI.end());
-					auto tgtF = tgtIt->second.value.get<std::vector<float>>();
-					ps.value = curF;
-					if(curF.size() != tgtF.size()) {
-						differs = true;
-					} else {
-						for(size_t k = 0; k < curF.size(); ++k) {
-							if(std::fabs(curF[k] - tgtF[k]) > 1e-6f) {
-								differs = true;
-								break;
-							}
-						}
-					}
+				else if(track.type == typeid(std::vector<int>).name()) {
+					track.kind = InterpolationKind::IntVector;
+					const auto &curI = oParam->cast<std::vector<int>>().getParameter().get();
+					from.assign(curI.begin(), curI.end());
+					to = tgtJson.get<std::vector<float>>();
+					differs = !floatVectorsEqual(from, to);
 				}
-				else if(ps.type == typeid(ofColor).name()) {
+				else if(track.type == typeid(ofColor).name()) {
+					track.kind = InterpolationKind::Color;
 					auto cur = oParam->cast<ofColor>().getParameter().get();
-					auto& tgtJson = tgtIt->second.value;
-					ps.value = ofJson{{"r", (int)cur.r}, {"g", (int)cur.g}, {"b", (int)cur.b}, {"a", (int)cur.a}};
-					if(cur.r != tgtJson["r"].get<int>() || cur.g != tgtJson["g"].get<int>() ||
-					   cur.b != tgtJson["b"].get<int>() || cur.a != tgtJson["a"].get<int>()) {
-						differs = true;
-					}
+					from = { (float)cur.r, (float)cur.g, (float)cur.b, (float)cur.a };
+					to   = { (float)tgtJson.at("r").get<int>(), (float)tgtJson.at("g").get<int>(),
+					         (float)tgtJson.at("b").get<int>(), (float)tgtJson.at("a").get<int>() };
+					differs = from != to;
 				}
-				else if(ps.type == typeid(ofFloatColor).name()) {
+				else if(track.type == typeid(ofFloatColor).name()) {
+					track.kind = InterpolationKind::FloatColor;
 					auto cur = oParam->cast<ofFloatColor>().getParameter().get();
-					auto& tgtJson = tgtIt->second.value;
-					ps.value = ofJson{{"r", cur.r}, {"g", cur.g}, {"b", cur.b}, {"a", cur.a}};
-					if(!floatsEqual(cur.r, tgtJson["r"].get<float>()) || !floatsEqual(cur.g, tgtJson["g"].get<float>()) ||
-					   !floatsEqual(cur.b, tgtJson["b"].get<float>()) || !floatsEqual(cur.a, tgtJson["a"].get<float>())) {
-						differs = true;
-					}
+					from = { cur.r, cur.g, cur.b, cur.a };
+					to   = { tgtJson.at("r").get<float>(), tgtJson.at("g").get<float>(),
+					         tgtJson.at("b").get<float>(), tgtJson.at("a").get<float>() };
+					differs = !floatVectorsEqual(from, to);
 				}
-				else {
+				else if(track.type == typeid(bool).name()) {
+					track.kind = InterpolationKind::Bool;
+					to = { tgtJson.get<bool>() ? 1.0f : 0.0f };
+					from = to;
+					differs = true;
+				}
+				else if(track.type == typeid(std::string).name()) {
+					track.kind = InterpolationKind::String;
+					interpolationStringTargets.push_back(tgtJson.get<std::string>());
+					track.offset = interpolationStringTargets.size() - 1;
 					differs = true;
-					if(ps.type == typeid(bool).name()) {
-						ps.value = oParam->cast<bool>().getParameter().get();
-					} else if(ps.type == typeid(std::string).name()) {
-						ps.value = oParam->cast<std::string>().getParameter().get();
-					}
 				}
 
-				interpolationStartValues[key] = ps;
+				// Vectors whose length changed can't be lerped element-wise; they are left as-is
+				if(!differs || from.size() != to.size()) continue;
 
-				if(differs) {
-					interpolationActiveKeys.insert(key);
+				track.param = newInterpolationHandle(oParam, track.kind);
+				if(track.kind != InterpolationKind::String) {
+					track.offset = interpolationFrom.size();
+					track.count  = from.size();
+					interpolationFrom.insert(interpolationFrom.end(), from.begin(), from.end());
+					interpolationTo.insert(interpolationTo.end(), to.begin(), to.end());
 				}
+				interpolationTracks.push_back(std::move(track));
 			} catch(...) {
 				// Skip
 			}
 		}
 	}
-	
+
+	interpolationModuleSignature = computeModuleSignature();
 	isInterpolating = true;
 	interpolationStartTime = ofGetElapsedTimeMillis();
 	interpolationTargetSlot = targetSlot;
 	transition = 0.0f;
 }
 
+std::shared_ptr<ofAbstractParameter> globalSnapshots::newInterpolationHandle(ofxOceanodeAbstractParameter* param, InterpolationKind kind) {
+	switch(kind) {
+		case InterpolationKind::Float:       return param->cast<float>().getParameter().newReference();
+		case InterpolationKind::Int:         return param->cast<int>().getParameter().newReference();
+		case InterpolationKind::FloatVector: return param->cast<std::vector<float>>().getParameter().newReference();
+		case InterpolationKind::IntVector:   return param->cast<std::vector<int>>().getParameter().newReference();
+		case InterpolationKind::Color:       return param->cast<ofColor>().getParameter().newReference();
+		case InterpolationKind::FloatColor:  return param->cast<ofFloatColor>().getParameter().newReference();
+		case InterpolationKind::Bool:        return param->cast<bool>().getParameter().newReference();
+		case InterpolationKind::String:      return param->cast<std::string>().getParameter().newReference();
+	}
+	return nullptr;
+}
+
+size_t globalSnapshots::computeModuleSignature() const {
+	// O(parameters) fingerprint of the patch topology: node identities and the
+	// address of every parameter, so adding, removing or replacing any input
+	// re-resolves the tracks by name. Tracks own their values, so if a freed
+	// parameter's address is reused the only effect is that the track keeps
+	// writing to the orphaned value until the next change.
+	size_t h = 0;
+	for(auto *node : globalContainer->getAllModules()) {
+		h = (h * 1000003u) ^ std::hash<const void*>()(node);
+		if(!node) continue;
+		auto &grp = node->getParameters();
+		h = (h * 1000003u) ^ (size_t)grp.size();
+		for(int i = 0; i < grp.size(); i++) h = (h * 1000003u) ^ std::hash<const void*>()(&grp.get(i));
+	}
+	return h;
+}
+
+void globalSnapshots::resolveInterpolationTracks() {
+	std::unordered_map<std::string, size_t> trackIndex;
+	trackIndex.reserve(interpolationTracks.size());
+	for(size_t t = 0; t < interpolationTracks.size(); ++t) {
+		interpolationTracks[t].param.reset();
+		trackIndex[interpolationTracks[t].key] = t;
+	}
+
+	for(auto *node : globalContainer->getAllModules()) {
+		if (!node || &node->getNodeModel() == this) continue;
+
+		auto &grp = node->getParameters();
+		std::string grpName = grp.getEscapedName();
+
+		for(int i = 0; i < grp.size(); i++) {
+			auto &p = grp.get(i);
+			auto tit = trackIndex.find(grpName + "/" + p.getName());
+			if(tit == trackIndex.end()) continue;
+
+			auto *oParam = dynamic_cast<ofxOceanodeAbstractParameter*>(&p);
+			auto &track = interpolationTracks[tit->second];
+			if(oParam && oParam->valueType() == track.type) {
+				track.param = newInterpolationHandle(oParam, track.kind);
+			}
+		}
+	}
+
+	interpolationModuleSignature = computeModuleSignature();
+}
+
 void globalSnapshots::updateInterpolation() {
 	if (!isInterpolating || !globalContainer) return;
 	
@@ -924,107 +1113,82 @@ void globalSnapshots::updateInterpolation() {
 	// Update transition parameter with the eased progress
 	transition = easedProgress;
 	
-	auto targetSnapshot = snapshots.find(interpolationTargetSlot);
-	if(targetSnapshot == snapshots.end()) {
+	if(snapshots.find(interpolationTargetSlot) == snapshots.end()) {
 		isInterpolating = false;
+		interpolationTracks.clear();
 		return;
 	}
-	
-	for (const auto& key : interpolationActiveKeys) {
-		for (auto *node : globalContainer->getAllModules()) {
-			if (!node) continue;
-			
-			auto &grp = node->getParameters();
-			std::string grpName = grp.getEscapedName();
-			
-			for (int i = 0; i < grp.size(); i++) {
-				try {
-					auto &p = grp.get(i);
-					auto *oParam = dynamic_cast<ofxOceanodeAbstractParameter*>(&p);
-					if(!oParam) continue;
-					
-					std::string thisKey = grpName + "/" + p.getName();
-					if (thisKey != key) continue;
-					
-					auto startIt  = interpolationStartValues.find(key);
-					auto targetIt = targetSnapshot->second.paramValues.find(key);
-					if(startIt == interpolationStartValues.end() || targetIt == targetSnapshot->second.paramValues.end())
-						break;
-					
-					auto vtype = oParam->valueType();
-					if(vtype == typeid(float).name()) {
-						float startVal  = startIt->second.value.get<float>();
-						float targetVal = targetIt->second.value.get<float>();
-						float interpolatedVal = startVal + (targetVal - startVal) * easedProgress;
-						oParam->cast<float>().getParameter() = interpolatedVal;
-					}
-					else if(vtype == typeid(int).name()) {
-						float startVal  = startIt->second.value.get<float>();
-						float targetVal = targetIt->second.value.get<float>();
-						float interpolatedVal = startVal + (targetVal - startVal) * easedProgress;
-						oParam->cast<int>().getParameter() = static_cast<int>(std::round(interpolatedVal));
-					}
-					else if(vtype == typeid(std::vector<float>).name()) {
-						auto startVec  = startIt->second.value.get<std::vector<float>>();
-						auto targetVec = targetIt->second.value.get<std::vector<float>>();
-						if(startVec.size() == targetVec.size()) {
-							std::vector<float> interpolatedVec;
-							interpolatedVec.reserve(startVec.size());
-							for(size_t j = 0; j < startVec.size(); j++) {
-								float interpolatedVal = startVec[j] + (targetVec[j] - startVec[j]) * easedProgress;
-								interpolatedVec.push_back(interpolatedVal);
-							}
-							oParam->cast<std::vector<float>>().getParameter() = interpolatedVec;
-						}
-					}
-					else if(vtype == typeid(std::vector<int>).name()) {
-						auto startVec  = startIt->second.value.get<std::vector<float>>();
-						auto targetVec = targetIt->second.value.get<std::vector<float>>();
-						if(startVec.size() == targetVec.size()) {
-							std::vector<int> interpolatedVec;
-							interpolatedVec.reserve(startVec.size());
-							for(size_t j = 0; j < startVec.size(); j++) {
-								float interpolatedVal = startVec[j] + (targetVec[j] - startVec[j]) * easedProgress;
-								interpolatedVec.push_back(static_cast<int>(std::round(interpolatedVal)));
-							}
-							oParam->cast<std::vector<int>>().getParameter() = interpolatedVec;
-						}
+
+	// Re-bind by name if nodes or inputs were added/removed since the plan was built
+	if(computeModuleSignature() != interpolationModuleSignature) {
+		resolveInterpolationTracks();
+	}
+
+	auto lerp = [easedProgress](float a, float b) { return a + (b - a) * easedProgress; };
+
+	for (auto &track : interpolationTracks) {
+		if(!track.param) continue;
+
+		const float *from = interpolationFrom.data() + track.offset;
+		const float *to   = interpolationTo.data() + track.offset;
+
+		try {
+			switch(track.kind) {
+				case InterpolationKind::Float:
+					track.param->cast<float>() = lerp(from[0], to[0]);
+					break;
+				case InterpolationKind::Int:
+					track.param->cast<int>() = static_cast<int>(std::round(lerp(from[0], to[0])));
+					break;
+				case InterpolationKind::FloatVector:
+					interpolationFloatScratch.resize(track.count);
+					for(size_t j = 0; j < track.count; j++) {
+						interpolationFloatScratch[j] = lerp(from[j], to[j]);
 					}
-					else if(vtype == typeid(ofColor).name()) {
-						auto& s = startIt->second.value;
-						auto& t = targetIt->second.value;
-						ofColor c;
-						c.r = (int)std::round(s["r"].get<int>() + (t["r"].get<int>() - s["r"].get<int>()) * easedProgress);
-						c.g = (int)std::round(s["g"].get<int>() + (t["g"].get<int>() - s["g"].get<int>()) * easedProgress);
-						c.b = (int)std::round(s["b"].get<int>() + (t["b"].get<int>() - s["b"].get<int>()) * easedProgress);
-						c.a = (int)std::round(s["a"].get<int>() + (t["a"].get<int>() - s["a"].get<int>()) * easedProgress);
-						oParam->cast<ofColor>().getParameter() = c;
+					track.param->cast<std::vector<float>>() = interpolationFloatScratch;
+					break;
+				case InterpolationKind::IntVector:
+					interpolationIntScratch.resize(track.count);
+					for(size_t j = 0; j < track.count; j++) {
+						interpolationIntScratch[j] = static_cast<int>(std::round(lerp(from[j], to[j])));
 					}
-					else if(vtype == typeid(ofFloatColor).name()) {
-						auto& s = startIt->second.value;
-						auto& t = targetIt->second.value;
-						ofFloatColor c;
-						c.r = s["r"].get<float>() + (t["r"].get<float>() - s["r"].get<float>()) * easedProgress;
-						c.g = s["g"].get<float>() + (t["g"].get<float>() - s["g"].get<float>()) * easedProgress;
-						c.b = s["b"].get<float>() + (t["b"].get<float>() - s["b"].get<float>()) * easedProgress;
-						c.a = s["a"].get<float>() + (t["a"].get<float>() - s["a"].get<float>()) * easedProgress;
-						oParam->cast<ofFloatColor>().getParameter() = c;
+					track.param->cast<std::vector<int>>() = interpolationIntScratch;
+					break;
+				case InterpolationKind::Color: {
+					ofColor c;
+					c.r = (int)std::round(lerp(from[0], to[0]));
+					c.g = (int)std::round(lerp(from[1], to[1]));
+					c.b = (int)std::round(lerp(from[2], to[2]));
+					c.a = (int)std::round(lerp(from[3], to[3]));
+					track.param->cast<ofColor>() = c;
+				} break;
+				case InterpolationKind::FloatColor: {
+					ofFloatColor c;
+					c.r = lerp(from[0], to[0]);
+					c.g = lerp(from[1], to[1]);
+					c.b = lerp(from[2], to[2]);
+					c.a = lerp(from[3], to[3]);
+					track.param->cast<ofFloatColor>() = c;
+				} break;
+				// Discrete values switch once, halfway through the (uneased) transition
+				case InterpolationKind::Bool:
+					if(progress >= 0.5f && !track.discreteApplied) {
+						track.param->cast<bool>() = (to[0] != 0.0f);
+						track.discreteApplied = true;
 					}
-					else {
-						if(progress >= 0.5f) {
-							if(vtype == typeid(bool).name()) {
-								oParam->cast<bool>().getParameter() = targetIt->second.value.get<bool>();
-							} else if(vtype == typeid(std::string).name()) {
-								oParam->cast<std::string>().getParameter() = targetIt->second.value.get<std::string>();
-							}
-						}
+					break;
+				case InterpolationKind::String:
+					if(progress >= 0.5f && !track.discreteApplied) {
+						track.param->cast<std::string>() = interpolationStringTargets[track.offset];
+						track.discreteApplied = true;
 					}
 					break;
-				} catch(...) {
-					// Skip on any error during interpolation
-					continue;
-				}
 			}
+		} catch(...) {
+			// Skip on any error during interpolation
 		}
 	}
+
+	// Done: let deleted nodes' parameters go
+	if(!isInterpolating) interpolationTracks.clear();
 }
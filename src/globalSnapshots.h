@@ -5,10 +5,13 @@
 #include "ofxOceanodeContainer.h"
 #include "ofxOceanodeShared.h"
 #include "ofxOceanodeParameter.h"
+#include "globalSnapshotsBank.h"
 #include <map>
+#include <memory>
 #include <string>
 #include <functional>
 #include <unordered_set>
+#include <unordered_map>
 #include <set>
 #include <vector>
 
@@ -40,6 +43,7 @@ private:
 	ofParameter<int>    matrixRows, matrixCols;
 	ofParameter<float>  buttonSize;
 	ofParameter<bool>   showSnapshotNames;
+	ofParameter<bool>   binaryBank;
 
 	// In‐memory snapshot storage
 	struct ParameterSnapshot {
@@ -49,8 +53,11 @@ private:
 	struct SnapshotData {
 		std::string                                       name;
 		std::map<std::string,ParameterSnapshot>           paramValues;
+		bool                                              pending = false; // values not yet decoded from bank
 	};
 	std::map<int,SnapshotData>  snapshots;
+	// Open binary bank backing pending snapshots; slots decode on first recall
+	globalSnapshotsBank         bank;
 	int                          currentSnapshotSlot;
 	
 	// Interpolation state
@@ -58,8 +65,29 @@ private:
 	float                       interpolationStartTime;
 	int                         interpolationTargetSlot;
 	float                       interpolationBiPowValue; // BiPow value to use for current interpolation
-	std::map<std::string, ParameterSnapshot> interpolationStartValues;
-	std::unordered_set<std::string>          interpolationActiveKeys;
+
+	// Interpolation plan, resolved once in startInterpolation(): each track holds a
+	// reference to the parameter's value plus a span in the contiguous from/to
+	// buffers, so a frame is a flat lerp over the tracks instead of a key x node x
+	// param scan. The reference owns the value, so it never dangles when a node or
+	// one of its inputs goes away mid-interpolation.
+	enum class InterpolationKind { Float, Int, FloatVector, IntVector, Color, FloatColor, Bool, String };
+	struct InterpolationTrack {
+		std::string                     key;
+		std::string                     type;     // valueType() at resolve time
+		std::shared_ptr<ofAbstractParameter> param; // newReference() of the typed ofParameter
+		InterpolationKind               kind  = InterpolationKind::Float;
+		size_t                          offset = 0; // into interpolationFrom/To (String: into interpolationStringTargets)
+		size_t                          count  = 0;
+		bool                            discreteApplied = false;
+	};
+	std::vector<InterpolationTrack>  interpolationTracks;
+	std::vector<float>               interpolationFrom;
+	std::vector<float>               interpolationTo;
+	std::vector<std::string>         interpolationStringTargets;
+	std::vector<float>               interpolationFloatScratch;
+	std::vector<int>                 interpolationIntScratch;
+	size_t                           interpolationModuleSignature = 0;
 
 	// Manual blacklist of parameters (Group/Param strings)
 	std::set<std::string> manualExcludes;
@@ -73,11 +101,20 @@ private:
 	void loadSnapshot(int slot);
 	void startInterpolation(int targetSlot);
 	void updateInterpolation();
+	// Re-binds track handles after nodes/parameters were added or removed
+	void resolveInterpolationTracks();
+	size_t computeModuleSignature() const;
+	static std::shared_ptr<ofAbstractParameter> newInterpolationHandle(ofxOceanodeAbstractParameter* param, InterpolationKind kind);
 
 	// Persistence
 	void saveSnapshotsToFile();
 	void loadSnapshotsFromFile();
 	std::string getSnapshotsFilePath();
+	std::string getSnapshotsBankPath();
+	bool loadSnapshotsFromJson(const std::string& filePath);
+	bool loadSnapshotsFromBank(const std::string& filePath);
+	SnapshotData* getDecodedSnapshot(int slot);
+	bool decodePendingSnapshots();  // false if a slot failed to decode
 	void presetSave(ofJson &json) override;
 	void presetRecallAfterSettingParameters(ofJson &json) override;
 	void macroSave(ofJson &json, string path) override;
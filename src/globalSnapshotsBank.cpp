@@ -0,0 +1,416 @@
+#include "globalSnapshotsBank.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+
+#ifdef TARGET_WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	const char     kMagic[4] = {'G', 'S', 'N', 'B'};
+	const uint32_t kVersion  = 1;
+
+	struct FileHeader {
+		char     magic[4];
+		uint32_t version;
+		uint32_t stringCount;
+		uint32_t slotCount;
+		uint32_t excludedCount;
+		uint32_t reserved;
+		uint64_t stringsOffset;
+		uint64_t slotsOffset;
+		uint64_t excludedOffset;
+	};
+	struct SlotRecord {
+		int32_t  slot;
+		uint32_t nameId;
+		uint32_t entryCount;
+		uint32_t reserved;
+		uint64_t offset;
+		uint64_t size;
+	};
+	struct EntryHeader {
+		uint32_t keyId;
+		uint32_t typeId;
+		uint8_t  kind;
+		uint8_t  pad[3];
+		uint32_t count;
+	};
+
+	// Unaligned-safe reads from the mapping
+	template<typename T>
+	bool readAt(const uint8_t* base, size_t size, uint64_t offset, T& out) {
+		if(offset > size || size - offset < sizeof(T)) return false;
+		std::memcpy(&out, base + offset, sizeof(T));
+		return true;
+	}
+
+	template<typename T>
+	void append(std::vector<uint8_t>& buf, const T& v) {
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+		buf.insert(buf.end(), p, p + sizeof(T));
+	}
+	void appendBytes(std::vector<uint8_t>& buf, const void* src, size_t n) {
+		const uint8_t* p = static_cast<const uint8_t*>(src);
+		buf.insert(buf.end(), p, p + n);
+		while(buf.size() % 4) buf.push_back(0);
+	}
+	size_t padded(size_t n) { return (n + 3) & ~size_t(3); }
+
+	// Atomically swaps `from` in as `to`; the old `to` stays intact until then
+	bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef TARGET_WIN32
+		return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+	}
+}
+
+globalSnapshotsBank::~globalSnapshotsBank() {
+	close();
+}
+
+// ----------------------------------------------------------
+// Reading
+// ----------------------------------------------------------
+bool globalSnapshotsBank::open(const std::string& path) {
+	close();
+
+#ifdef TARGET_WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file != INVALID_HANDLE_VALUE) {
+		LARGE_INTEGER sz;
+		if(GetFileSizeEx(file, &sz) && sz.QuadPart > 0) {
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if(mapping) {
+				void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				if(view) {
+					data = static_cast<const uint8_t*>(view);
+					dataSize = (size_t)sz.QuadPart;
+					fileHandle = file;
+					mappingHandle = mapping;
+					mapped = true;
+				} else {
+					CloseHandle(mapping);
+				}
+			}
+		}
+		if(!mapped) CloseHandle(file);
+	}
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd >= 0) {
+		struct stat st;
+		if(fstat(fd, &st) == 0 && st.st_size > 0) {
+			void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(view != MAP_FAILED) {
+				data = static_cast<const uint8_t*>(view);
+				dataSize = (size_t)st.st_size;
+				mapped = true;
+			}
+		}
+		::close(fd); // the mapping stays valid after the descriptor is closed
+	}
+#endif
+
+	if(!mapped) {
+		// Fall back to a single read
+		std::ifstream in(path, std::ios::binary | std::ios::ate);
+		if(!in) return false;
+		std::streamsize sz = in.tellg();
+		if(sz <= 0) return false;
+		fallbackBuffer.resize((size_t)sz);
+		in.seekg(0);
+		if(!in.read(reinterpret_cast<char*>(fallbackBuffer.data()), sz)) {
+			fallbackBuffer.clear();
+			return false;
+		}
+		data = fallbackBuffer.data();
+		dataSize = fallbackBuffer.size();
+	}
+
+	FileHeader header{};
+	if(!readAt(data, dataSize, 0, header)
+		|| std::memcmp(header.magic, kMagic, 4) != 0
+		|| header.version != kVersion) {
+		ofLogError("globalSnapshotsBank") << "Not a snapshot bank: " << path;
+		close();
+		return false;
+	}
+	bool ok = true;
+
+	// String table: views into the mapping, nothing is copied
+	uint64_t pos = header.stringsOffset;
+	if(ok) strings.reserve(header.stringCount);
+	for(uint32_t i = 0; ok && i < header.stringCount; ++i) {
+		uint32_t len = 0;
+		ok = readAt(data, dataSize, pos, len) && dataSize - pos - 4 >= len;
+		if(ok) {
+			strings.emplace_back(reinterpret_cast<const char*>(data + pos + 4), len);
+			pos += 4 + padded(len);
+		}
+	}
+
+	for(uint32_t i = 0; ok && i < header.slotCount; ++i) {
+		SlotRecord rec;
+		ok = readAt(data, dataSize, header.slotsOffset + i * sizeof(SlotRecord), rec)
+			&& rec.nameId < strings.size()
+			&& rec.offset <= dataSize && dataSize - rec.offset >= rec.size;
+		if(ok) {
+			SlotInfo info;
+			info.nameId = rec.nameId;
+			info.entryCount = rec.entryCount;
+			info.offset = rec.offset;
+			info.size = rec.size;
+			slots[rec.slot] = info;
+		}
+	}
+
+	for(uint32_t i = 0; ok && i < header.excludedCount; ++i) {
+		uint32_t id = 0;
+		ok = readAt(data, dataSize, header.excludedOffset + i * 4, id) && id < strings.size();
+		if(ok) excluded.push_back(id);
+	}
+
+	if(!ok) {
+		ofLogError("globalSnapshotsBank") << "Invalid or corrupt snapshot bank: " << path;
+		close();
+	}
+	return ok;
+}
+
+void globalSnapshotsBank::close() {
+	if(mapped && data) {
+#ifdef TARGET_WIN32
+		UnmapViewOfFile(data);
+		CloseHandle((HANDLE)mappingHandle);
+		CloseHandle((HANDLE)fileHandle);
+		mappingHandle = nullptr;
+		fileHandle = nullptr;
+#else
+		munmap(const_cast<uint8_t*>(data), dataSize);
+#endif
+	}
+	mapped = false;
+	data = nullptr;
+	dataSize = 0;
+	fallbackBuffer.clear();
+	fallbackBuffer.shrink_to_fit();
+	strings.clear();
+	slots.clear();
+	excluded.clear();
+}
+
+std::string globalSnapshotsBank::stringAt(uint32_t id) const {
+	if(id >= strings.size()) return "";
+	return std::string(strings[id].first, strings[id].second);
+}
+
+std::vector<int> globalSnapshotsBank::getSlots() const {
+	std::vector<int> out;
+	out.reserve(slots.size());
+	for(const auto& s : slots) out.push_back(s.first);
+	return out;
+}
+
+std::string globalSnapshotsBank::getSlotName(int slot) const {
+	auto it = slots.find(slot);
+	return it != slots.end() ? stringAt(it->second.nameId) : "";
+}
+
+std::vector<std::string> globalSnapshotsBank::getExcluded() const {
+	std::vector<std::string> out;
+	out.reserve(excluded.size());
+	for(auto id : excluded) out.push_back(stringAt(id));
+	return out;
+}
+
+bool globalSnapshotsBank::decodeSlot(int slot, const std::function<void(const std::string&, const std::string&, ofJson&&)>& visit) const {
+	auto it = slots.find(slot);
+	if(it == slots.end() || !data) return false;
+
+	uint64_t pos = it->second.offset;
+	const uint64_t end = pos + it->second.size;
+	std::vector<float> floats;
+
+	for(uint32_t e = 0; e < it->second.entryCount; ++e) {
+		EntryHeader eh;
+		if(!readAt(data, (size_t)end, pos, eh) || eh.keyId >= strings.size() || eh.typeId >= strings.size()) return false;
+		pos += sizeof(EntryHeader);
+
+		const bool textPayload = (eh.kind == String || eh.kind == Json);
+		const uint64_t payload = textPayload ? padded(eh.count) : uint64_t(eh.count) * 4;
+		if(end - pos < payload) return false;
+
+		ofJson value;
+		if(textPayload) {
+			std::string text(reinterpret_cast<const char*>(data + pos), eh.count);
+			if(eh.kind == String) value = std::move(text);
+			else                  value = ofJson::parse(text, nullptr, false);
+		} else {
+			floats.resize(eh.count);
+			if(eh.count) std::memcpy(floats.data(), data + pos, eh.count * 4);
+			switch(eh.kind) {
+				case Float:      value = eh.count ? floats[0] : 0.0f; break;
+				case Bool:       value = eh.count ? floats[0] != 0.0f : false; break;
+				case FloatArray: value = floats; break;
+				case Color:
+					if(eh.count == 4) value = ofJson{{"r", (int)floats[0]}, {"g", (int)floats[1]}, {"b", (int)floats[2]}, {"a", (int)floats[3]}};
+					break;
+				case FloatColor:
+					if(eh.count == 4) value = ofJson{{"r", floats[0]}, {"g", floats[1]}, {"b", floats[2]}, {"a", floats[3]}};
+					break;
+				default: break;
+			}
+		}
+		pos += payload;
+
+		visit(stringAt(eh.keyId), stringAt(eh.typeId), std::move(value));
+	}
+	return true;
+}
+
+// ----------------------------------------------------------
+// Writing
+// ----------------------------------------------------------
+uint32_t globalSnapshotsBank::intern(const std::string& s) {
+	auto it = outStringIds.find(s);
+	if(it != outStringIds.end()) return it->second;
+	uint32_t id = (uint32_t)outStrings.size();
+	outStrings.push_back(s);
+	outStringIds.emplace(s, id);
+	return id;
+}
+
+void globalSnapshotsBank::beginSlot(int slot, const std::string& name) {
+	PendingSlot ps;
+	ps.slot = slot;
+	ps.nameId = intern(name);
+	outSlots.push_back(std::move(ps));
+}
+
+void globalSnapshotsBank::addValue(const std::string& key, const std::string& type, const ofJson& value) {
+	if(outSlots.empty()) return;
+	auto& bytes = outSlots.back().bytes;
+
+	EntryHeader eh{};
+	eh.keyId = intern(key);
+	eh.typeId = intern(type);
+
+	auto isColorObject = [&](bool& ints) {
+		if(!value.is_object() || value.size() != 4) return false;
+		ints = true;
+		for(const char* c : {"r", "g", "b", "a"}) {
+			auto it = value.find(c);
+			if(it == value.end() || !it->is_number()) return false;
+			ints = ints && it->is_number_integer();
+		}
+		return true;
+	};
+
+	std::vector<float> floats;
+	std::string text;
+	bool ints = false;
+
+	if(value.is_number()) {
+		eh.kind = Float;
+		floats.push_back(value.get<float>());
+	} else if(value.is_boolean()) {
+		eh.kind = Bool;
+		floats.push_back(value.get<bool>() ? 1.0f : 0.0f);
+	} else if(value.is_string()) {
+		eh.kind = String;
+		text = value.get<std::string>();
+	} else if(value.is_array() && std::all_of(value.begin(), value.end(), [](const ofJson& v){ return v.is_number(); })) {
+		eh.kind = FloatArray;
+		floats = value.get<std::vector<float>>();
+	} else if(isColorObject(ints)) {
+		eh.kind = ints ? Color : FloatColor;
+		floats = { value["r"].get<float>(), value["g"].get<float>(), value["b"].get<float>(), value["a"].get<float>() };
+	} else {
+		eh.kind = Json;
+		text = value.dump();
+	}
+
+	if(eh.kind == String || eh.kind == Json) {
+		eh.count = (uint32_t)text.size();
+		append(bytes, eh);
+		appendBytes(bytes, text.data(), text.size());
+	} else {
+		eh.count = (uint32_t)floats.size();
+		append(bytes, eh);
+		appendBytes(bytes, floats.data(), floats.size() * sizeof(float));
+	}
+	outSlots.back().entryCount++;
+}
+
+void globalSnapshotsBank::addExcluded(const std::string& key) {
+	outExcluded.push_back(intern(key));
+}
+
+bool globalSnapshotsBank::save(const std::string& path) {
+	std::vector<uint8_t> buf;
+
+	FileHeader header{};
+	std::memcpy(header.magic, kMagic, 4);
+	header.version = kVersion;
+	header.stringCount = (uint32_t)outStrings.size();
+	header.slotCount = (uint32_t)outSlots.size();
+	header.excludedCount = (uint32_t)outExcluded.size();
+	append(buf, header);
+
+	header.stringsOffset = buf.size();
+	for(const auto& s : outStrings) {
+		append(buf, (uint32_t)s.size());
+		appendBytes(buf, s.data(), s.size());
+	}
+
+	// Slot table is written after the arena offsets are known
+	header.slotsOffset = buf.size();
+	buf.resize(buf.size() + outSlots.size() * sizeof(SlotRecord));
+
+	header.excludedOffset = buf.size();
+	for(auto id : outExcluded) append(buf, id);
+
+	for(size_t i = 0; i < outSlots.size(); ++i) {
+		const auto& ps = outSlots[i];
+		SlotRecord rec{};
+		rec.slot = ps.slot;
+		rec.nameId = ps.nameId;
+		rec.entryCount = ps.entryCount;
+		rec.offset = buf.size();
+		rec.size = ps.bytes.size();
+		buf.insert(buf.end(), ps.bytes.begin(), ps.bytes.end());
+		std::memcpy(buf.data() + header.slotsOffset + i * sizeof(SlotRecord), &rec, sizeof(rec));
+	}
+	std::memcpy(buf.data(), &header, sizeof(header));
+
+	outStrings.clear();
+	outStringIds.clear();
+	outSlots.clear();
+	outExcluded.clear();
+
+	// Write next to the target and swap in, so a failed write never truncates the bank
+	std::string tmpPath = path + ".tmp";
+	{
+		std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+		if(!out || !out.write(reinterpret_cast<const char*>(buf.data()), (std::streamsize)buf.size())) {
+			ofLogError("globalSnapshotsBank") << "Failed to write snapshot bank: " << tmpPath;
+			return false;
+		}
+	}
+	if(!replaceFile(tmpPath, path)) {
+		ofLogError("globalSnapshotsBank") << "Failed to replace snapshot bank: " << path;
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,90 @@
+#ifndef GLOBAL_SNAPSHOTS_BANK_H
+#define GLOBAL_SNAPSHOTS_BANK_H
+
+#include "ofMain.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary snapshot bank for globalSnapshots.
+//
+// Layout (host byte order, every section 4-byte aligned):
+//   header        magic "GSNB", version, counts and section offsets
+//   string table  every key, type name, slot name and exclude, interned once
+//   slot table    slot id, name id, entry count, data offset/size
+//   excludes      string ids
+//   value arena   per slot: { keyId, typeId, kind, count, payload } entries,
+//                 payload = count floats, or count bytes of text for String/Json
+//
+// open() memory-maps the file and only parses the header, string and slot
+// tables; a slot's values are decoded when decodeSlot() is called for it.
+class globalSnapshotsBank {
+public:
+	globalSnapshotsBank() = default;
+	~globalSnapshotsBank();
+	globalSnapshotsBank(const globalSnapshotsBank&) = delete;
+	globalSnapshotsBank& operator=(const globalSnapshotsBank&) = delete;
+
+	// ---- Reading ----
+	bool open(const std::string& path);
+	void close();
+	bool isOpen() const { return data != nullptr; }
+
+	std::vector<int> getSlots() const;
+	std::string getSlotName(int slot) const;
+	std::vector<std::string> getExcluded() const;
+
+	// Calls visit(key, type, value) for every parameter stored in the slot
+	bool decodeSlot(int slot, const std::function<void(const std::string&, const std::string&, ofJson&&)>& visit) const;
+
+	// ---- Writing ----
+	void beginSlot(int slot, const std::string& name);
+	void addValue(const std::string& key, const std::string& type, const ofJson& value);
+	void addExcluded(const std::string& key);
+	bool save(const std::string& path);
+
+private:
+	enum Kind : uint8_t { Float, Bool, String, FloatArray, Color, FloatColor, Json };
+
+	struct SlotInfo {
+		uint32_t nameId = 0;
+		uint32_t entryCount = 0;
+		uint64_t offset = 0;
+		uint64_t size = 0;
+	};
+
+	// mapping
+	const uint8_t*       data = nullptr;
+	size_t               dataSize = 0;
+	std::vector<uint8_t> fallbackBuffer; // used when the platform can't map the file
+#ifdef TARGET_WIN32
+	void*                fileHandle = nullptr;
+	void*                mappingHandle = nullptr;
+#endif
+	bool                 mapped = false;
+
+	std::vector<std::pair<const char*, uint32_t>> strings; // views into data
+	std::map<int, SlotInfo>                       slots;
+	std::vector<uint32_t>                         excluded;
+
+	std::string stringAt(uint32_t id) const;
+
+	// builder state
+	struct PendingSlot {
+		int slot;
+		uint32_t nameId;
+		uint32_t entryCount = 0;
+		std::vector<uint8_t> bytes;
+	};
+	std::vector<std::string>                  outStrings;
+	std::unordered_map<std::string, uint32_t> outStringIds;
+	std::vector<PendingSlot>                  outSlots;
+	std::vector<uint32_t>                     outExcluded;
+
+	uint32_t intern(const std::string& s);
+};
+
+#endif // GLOBAL_SNAPSHOTS_BANK_H
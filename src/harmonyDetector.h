@@ -2,38 +2,40 @@
 #define harmonyDetector_h
 
 #include "ofxOceanodeNodeModel.h"
+#include "pitchClassMatcher.h"
+#include "pitchClassHistogram.h"
+#include "sequencerContext.h"
+#include "harmonyLibraryStore.h"
 #include <set>
 #include <map>
 #include <algorithm>
 #include <sstream>
 
-struct HarmonyPattern {
-	string name;
-	set<int> intervals; // Relative to root (0)
-	
-	HarmonyPattern(const string& n, const set<int>& i) : name(n), intervals(i) {}
-};
-
 class harmonyDetector : public ofxOceanodeNodeModel {
 public:
 	harmonyDetector() : ofxOceanodeNodeModel("Harmony Detector") {}
 	
 	void setup() override {
-		description = "Detects chords and scales from incoming pitch values. Converts pitches to pitch classes (mod 12), finds root note, and identifies chord/scale quality. Reads definitions from chords.txt and scales.txt files.";
+		description = "Detects chords and scales from incoming pitch values. Converts pitches to pitch classes (mod 12), finds root note, and identifies chord/scale quality. Reads definitions from chords.txt and scales.txt files. Window mode integrates held pitches into a histogram that decays with Half Life (s), correlates it with the 24 Krumhansl-Kessler key profiles every frame, and detects chord/scale from the classes above Threshold (relative to the strongest).";
 		
 		addParameter(pitchInput.set("Pitch", {60}, {0}, {127}));
 		addParameter(accumMode.set("Accum", false));
 		addParameter(clearAccum.set("Clear"));
+		addParameter(windowMode.set("Window", false));
+		addParameter(halfLife.set("Half Life", 4.0f, 0.05f, 60.0f));
+		addParameter(threshold.set("Threshold", 0.3f, 0.0f, 1.0f));
 		addOutputParameter(detectedChord.set("Chord", "none"));
 		addOutputParameter(detectedScale.set("Scale", "none"));
 		addOutputParameter(pitchClasses.set("Pitch Classes", {0}, {0}, {11}));
+		addOutputParameter(histogramOutput.set("Histogram", vector<float>(12, 0.0f), {0.0f}, {1.0f}));
+		addOutputParameter(detectedKey.set("Key", "none"));
+		addOutputParameter(keyScores.set("Key Scores", vector<float>(pitchClassHistogram::NUM_KEYS, 0.0f), {-1.0f}, {1.0f}));
 		
 		// Note names for root identification
 		noteNames = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
 		
-		// Load chord and scale databases from files
-		loadChordsFromFile();
-		loadScalesFromFile();
+		// Load chord and scale databases from files (shared between nodes)
+		loadLibraries();
 		
 		// Add listeners
 		listener = pitchInput.newListener([this](vector<float> &vf){
@@ -41,90 +43,91 @@ public:
 		});
 		
 		clearListener = clearAccum.newListener([this](){
-			accumulatedPitchClasses.clear();
+			accumulatedMask = 0;
+			histogram.clear();
 			analyzeHarmony();
 		});
+		
+		windowListener = windowMode.newListener([this](bool &){
+			lastMask = -1;
+			analyzeHarmony();
+		});
+		
+		libraryListener = harmonyLibraryStore::get().changed.newListener([this](string &path){
+			if (!harmonyLibraryStore::samePath(path, getLibraryPath("chords.txt")) &&
+				!harmonyLibraryStore::samePath(path, getLibraryPath("scales.txt"))) return;
+			loadLibraries();
+			lastMask = -1;
+			analyzeHarmony();
+		});
+	}
+	
+	void update(ofEventArgs &) override {
+		uint64_t now = sequencerContext::get().nowMicros();
+		double dt = lastUpdateUs == 0 ? 0.0 : (now - lastUpdateUs) / 1e6;
+		lastUpdateUs = now;
+		if (!windowMode) return;
+		
+		// Held pitch classes accumulate seconds; everything fades by half every Half Life
+		histogram.decay(exp2(-dt / halfLife.get()));
+		for (int pc = 0; pc < 12; pc++) {
+			if (heldVoices[pc] > 0) histogram.add(pc, heldVoices[pc] * dt);
+		}
+		publishWindow();
 	}
 	
 private:
 	ofParameter<vector<float>> pitchInput;
 	ofParameter<bool> accumMode;
 	ofParameter<void> clearAccum;
+	ofParameter<bool> windowMode;
+	ofParameter<float> halfLife;
+	ofParameter<float> threshold;
 	ofParameter<string> detectedChord;
 	ofParameter<string> detectedScale;
 	ofParameter<vector<int>> pitchClasses;
-	ofEventListener listener, clearListener;
+	ofParameter<vector<float>> histogramOutput;
+	ofParameter<string> detectedKey;
+	ofParameter<vector<float>> keyScores;
+	ofEventListener listener, clearListener, windowListener, libraryListener;
 	
-	vector<HarmonyPattern> chords;
-	vector<HarmonyPattern> scales;
+	// Libraries compiled to masks, with the 4096-entry lookup table
+	shared_ptr<const pitchClassMatcher> chords;
+	shared_ptr<const pitchClassMatcher> scales;
 	vector<string> noteNames;
-	set<int> accumulatedPitchClasses; // For accumulation mode
+	uint16_t accumulatedMask = 0; // For accumulation mode
+	int lastMask = -1;            // input of the current outputs
 	
-	void loadChordsFromFile() {
-		string filePath = ofToDataPath("Supercollider/Pitchclass/chords.txt");
-		ofFile file(filePath);
-		
-		if (!file.exists()) {
-			ofLogError("harmonyDetector") << "Could not find chords.txt at: " << filePath;
-			return;
-		}
-		
-		ofBuffer buffer = file.readToBuffer();
-		
-		for (auto line : buffer.getLines()) {
-			if (line.empty()) continue;
-			
-			// Parse line format: "id, name interval1 interval2 interval3...;"
-			size_t commaPos = line.find(',');
-			if (commaPos == string::npos) continue;
-			
-			string remainder = line.substr(commaPos + 1);
-			
-			// Remove trailing semicolon if present
-			if (!remainder.empty() && remainder.back() == ';') {
-				remainder.pop_back();
-			}
-			
-			// Trim whitespace
-			remainder = ofTrim(remainder);
-			
-			// Find first space to separate name from intervals
-			size_t spacePos = remainder.find(' ');
-			if (spacePos == string::npos) continue;
-			
-			string chordName = remainder.substr(0, spacePos);
-			string intervalString = remainder.substr(spacePos + 1);
-			
-			// Parse intervals
-			set<int> intervalSet;
-			stringstream ss(intervalString);
-			string interval;
-			
-			while (ss >> interval) {
-				int intervalValue = ofToInt(interval);
-				intervalSet.insert(intervalValue % 12); // Apply mod 12
-			}
-			
-			if (!intervalSet.empty()) {
-				chords.emplace_back(chordName, intervalSet);
-			}
-		}
-		
-		// Sort chords by size (smaller first for exact match priority)
-		std::sort(chords.begin(), chords.end(), [](const HarmonyPattern& a, const HarmonyPattern& b) {
-			return a.intervals.size() < b.intervals.size();
-		});
-		
-		ofLogNotice("harmonyDetector") << "Loaded " << chords.size() << " chord patterns";
+	// Window mode
+	pitchClassHistogram histogram;
+	array<int, 12> heldVoices{};  // voices per pitch class in the current input
+	uint64_t lastUpdateUs = 0;
+	int lastKey = -1;
+	vector<float> histogramValues = vector<float>(12, 0.0f);
+	vector<float> keyScoreValues = vector<float>(pitchClassHistogram::NUM_KEYS, 0.0f);
+	
+	static string getLibraryPath(const string &fileName) {
+		return ofToDataPath("Supercollider/Pitchclass/" + fileName);
+	}
+	
+	void loadLibraries() {
+		chords = harmonyLibraryStore::get().load<pitchClassMatcher>(
+			getLibraryPath("chords.txt"), "pitchClassMatcher",
+			[](const string &path){ return parseLibrary(path, "chord"); });
+		scales = harmonyLibraryStore::get().load<pitchClassMatcher>(
+			getLibraryPath("scales.txt"), "pitchClassMatcher",
+			[](const string &path){ return parseLibrary(path, "scale"); });
 	}
 	
-	void loadScalesFromFile() {
-		string filePath = ofToDataPath("Supercollider/Pitchclass/scales.txt");
+	// chords.txt / scales.txt; runs on the store's watcher thread on reload
+	static pitchClassMatcher parseLibrary(const string &filePath, const string &kind) {
+		pitchClassMatcher library;
 		ofFile file(filePath);
 		
 		if (!file.exists()) {
-			ofLogError("harmonyDetector") << "Could not find scales.txt at: " << filePath;
-			return;
+			ofLogError("harmonyDetector") << "Could not find " << kind << "s.txt at: " << filePath;
+			library.compile(false);
+			return library;
 		}
 		
 		ofBuffer buffer = file.readToBuffer();
@@ -150,7 +153,7 @@ private:
 			size_t spacePos = remainder.find(' ');
 			if (spacePos == string::npos) continue;
 			
-			string scaleName = remainder.substr(0, spacePos);
+			string patternName = remainder.substr(0, spacePos);
 			string intervalString = remainder.substr(spacePos + 1);
 			
 			// Parse intervals
@@ -164,79 +167,82 @@ private:
 			}
 			
 			if (!intervalSet.empty()) {
-				scales.emplace_back(scaleName, intervalSet);
+				library.add(patternName, pitchClassMask::fromIntervals(intervalSet));
 			}
 		}
 		
-		// Sort scales by size (smaller first for exact match priority)
-		std::sort(scales.begin(), scales.end(), [](const HarmonyPattern& a, const HarmonyPattern& b) {
-			return a.intervals.size() < b.intervals.size();
-		});
+		// Sorts by size (smaller first for exact match priority) and builds the lookup table
+		library.compile(true);
 		
-		ofLogNotice("harmonyDetector") << "Loaded " << scales.size() << " scale patterns";
+		ofLogNotice("harmonyDetector") << "Loaded " << library.size() << " " << kind << " patterns";
+		return library;
 	}
 	
-	// Transpose a set of pitch classes by a given amount
-	set<int> transposePitchClasses(const set<int>& pitchClasses, int transposition) {
-		set<int> transposed;
-		for (int pc : pitchClasses) {
-			transposed.insert((pc - transposition + 12) % 12);
-		}
-		return transposed;
+	string describe(const pitchClassMatcher& library, uint16_t mask) {
+		pitchClassMatcher::Match m = library.match(mask);
+		return m.found() ? noteNames[m.root] + " " + library.name(m.pattern) : "none";
 	}
 	
-	// Find the best root note for a given pattern against input pitch classes
-	pair<int, bool> findBestRoot(const HarmonyPattern& pattern, const set<int>& inputPitchClasses, bool exactMatch) {
-		for (int root = 0; root < 12; root++) {
-			// Transpose the input to this potential root
-			set<int> transposedInput = transposePitchClasses(inputPitchClasses, root);
-			
-			if (exactMatch) {
-				if (pattern.intervals == transposedInput) {
-					return make_pair(root, true);
-				}
-			} else {
-				// Check if pattern is contained in transposed input
-				if (std::includes(transposedInput.begin(), transposedInput.end(),
-								pattern.intervals.begin(), pattern.intervals.end())) {
-					return make_pair(root, true);
-				}
-			}
+	// Seconds of weight below which the window counts as silent
+	static constexpr double SILENT_WEIGHT = 1e-3;
+	
+	void publishWindow() {
+		double peak = 0.0;
+		for (int pc = 0; pc < 12; pc++) peak = std::max(peak, histogram.bin(pc));
+		bool silent = histogram.total() < SILENT_WEIGHT;
+		for (int pc = 0; pc < 12; pc++) {
+			histogramValues[pc] = silent ? 0.0f : float(histogram.bin(pc) / peak);
+		}
+		for (int k = 0; k < pitchClassHistogram::NUM_KEYS; k++) {
+			keyScoreValues[k] = silent ? 0.0f : float(histogram.keyScore(k));
+		}
+		histogramOutput = histogramValues;
+		keyScores = keyScoreValues;
+		
+		int key = silent ? -1 : histogram.bestKey();
+		if (key != lastKey) {
+			lastKey = key;
+			detectedKey = key < 0 ? "none" : noteNames[key % 12] + (key < 12 ? " major" : " minor");
 		}
-		return make_pair(-1, false);
+		
+		showMask(silent ? 0 : histogram.maskAbove(threshold.get()));
 	}
 	
 	void analyzeHarmony() {
+		if (windowMode) {
+			// Only the held voices change here; update() integrates them
+			heldVoices.fill(0);
+			for (float p : pitchInput.get()) heldVoices[pitchClassMask::pitchClassOf(p)]++;
+			return;
+		}
+		
 		if (pitchInput->empty()) {
 			if (!accumMode) {
 				detectedChord = "none";
 				detectedScale = "none";
 				pitchClasses = vector<int>();
+				lastMask = -1;
 			}
 			return;
 		}
 		
-		set<int> inputPitchClasses;
-		
+		uint16_t inputMask = pitchClassMask::fromPitches(pitchInput.get());
 		if (accumMode) {
 			// In accumulation mode, add new pitches to accumulated set
-			for (float pitch : pitchInput.get()) {
-				int pitchClass = ((int)round(pitch)) % 12;
-				if (pitchClass < 0) pitchClass += 12; // Handle negative values
-				accumulatedPitchClasses.insert(pitchClass);
-			}
-			inputPitchClasses = accumulatedPitchClasses;
-		} else {
-			// In normal mode, analyze current input only
-			for (float pitch : pitchInput.get()) {
-				int pitchClass = ((int)round(pitch)) % 12;
-				if (pitchClass < 0) pitchClass += 12; // Handle negative values
-				inputPitchClasses.insert(pitchClass);
-			}
+			accumulatedMask |= inputMask;
+			inputMask = accumulatedMask;
 		}
 		
+		showMask(inputMask);
+	}
+	
+	void showMask(uint16_t inputMask) {
+		// Same pitch-class set as last time: outputs are already current
+		if (inputMask == lastMask) return;
+		lastMask = inputMask;
+		
 		// Skip analysis if no pitch classes available
-		if (inputPitchClasses.empty()) {
+		if (inputMask == 0) {
 			detectedChord = "none";
 			detectedScale = "none";
 			pitchClasses = vector<int>();
@@ -244,76 +250,10 @@ private:
 		}
 		
 		// Output the pitch classes for visualization
-		vector<int> pcVector(inputPitchClasses.begin(), inputPitchClasses.end());
-		pitchClasses = pcVector;
-		
-		// Find best matching chord
-		string bestChord = "none";
-		
-		// First try exact matches
-		for (const auto& chord : chords) {
-			auto result = findBestRoot(chord, inputPitchClasses, true);
-			if (result.second) {
-				bestChord = noteNames[result.first] + " " + chord.name;
-				break;
-			}
-		}
-		
-		// If no exact match, try contained matches
-		if (bestChord == "none") {
-			HarmonyPattern* bestPattern = nullptr;
-			int bestRoot = -1;
-			
-			for (const auto& chord : chords) {
-				auto result = findBestRoot(chord, inputPitchClasses, false);
-				if (result.second) {
-					if (!bestPattern || chord.intervals.size() > bestPattern->intervals.size()) {
-						bestPattern = const_cast<HarmonyPattern*>(&chord);
-						bestRoot = result.first;
-					}
-				}
-			}
-			
-			if (bestPattern && bestRoot != -1) {
-				bestChord = noteNames[bestRoot] + " " + bestPattern->name;
-			}
-		}
-		
-		detectedChord = bestChord;
-		
-		// Find best matching scale
-		string bestScale = "none";
-		
-		// First try exact matches
-		for (const auto& scale : scales) {
-			auto result = findBestRoot(scale, inputPitchClasses, true);
-			if (result.second) {
-				bestScale = noteNames[result.first] + " " + scale.name;
-				break;
-			}
-		}
-		
-		// If no exact match, try contained matches
-		if (bestScale == "none") {
-			HarmonyPattern* bestPattern = nullptr;
-			int bestRoot = -1;
-			
-			for (const auto& scale : scales) {
-				auto result = findBestRoot(scale, inputPitchClasses, false);
-				if (result.second) {
-					if (!bestPattern || scale.intervals.size() > bestPattern->intervals.size()) {
-						bestPattern = const_cast<HarmonyPattern*>(&scale);
-						bestRoot = result.first;
-					}
-				}
-			}
-			
-			if (bestPattern && bestRoot != -1) {
-				bestScale = noteNames[bestRoot] + " " + bestPattern->name;
-			}
-		}
+		pitchClasses = pitchClassMask::toVector(inputMask);
 		
-		detectedScale = bestScale;
+		detectedChord = describe(*chords, inputMask);
+		detectedScale = describe(*scales, inputMask);
 	}
 };
 
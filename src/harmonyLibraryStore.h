@@ -0,0 +1,186 @@
+#ifndef harmonyLibraryStore_h
+#define harmonyLibraryStore_h
+
+#include "ofMain.h"
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Process-wide cache of the parsed harmony libraries (chords.txt, scales.txt,
+// functional_harmony.json, JazzStandards.json, ...).
+//
+// Each file is parsed once per form (the structure a node builds from it) and
+// handed out as shared_ptr<const T>, so twenty chordSequence nodes share one
+// copy. An entry lives while some node still holds its view.
+//
+// A background thread checks the files' modification times every second,
+// reparses changed ones off the main thread and swaps the new view in; the
+// `changed` event then fires on the main thread, before the app's update, with
+// the file's path. Nodes keep using the view they hold until they load again.
+class harmonyLibraryStore {
+public:
+	template<typename T>
+	using Parser = std::function<T(const std::string &path)>;
+
+	static harmonyLibraryStore& get() {
+		static harmonyLibraryStore instance;
+		return instance;
+	}
+
+	~harmonyLibraryStore() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		wake.notify_all();
+		if(worker.joinable()) worker.join();
+	}
+
+	// Path of a file reloaded since the last frame (main thread)
+	ofEvent<std::string> changed;
+
+	// For `changed` listeners: whether two spellings name the same file
+	static bool samePath(const std::string &a, const std::string &b) {
+		return keyFor(a, "") == keyFor(b, "");
+	}
+
+	// Parses on the first request for (path, form); later requests share the
+	// result. `parse` may run again on the watcher thread, so it must not
+	// capture the node.
+	template<typename T>
+	std::shared_ptr<const T> load(const std::string &path, const std::string &form, Parser<T> parse) {
+		std::string key = keyFor(path, form);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = entries.find(key);
+			if(it != entries.end()) return std::static_pointer_cast<const T>(it->second->value);
+		}
+
+		auto entry = std::make_shared<Entry>();
+		entry->path = path;
+		entry->parse = [parse](const std::string &p) -> std::shared_ptr<const void> {
+			return std::shared_ptr<const T>(std::make_shared<T>(parse(p)));
+		};
+		entry->modified = modificationTime(path);
+		entry->value = entry->parse(path);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		auto inserted = entries.emplace(key, entry).first;
+		if(!worker.joinable()) worker = std::thread([this]() { run(); });
+		return std::static_pointer_cast<const T>(inserted->second->value);
+	}
+
+	// Whole JSON document; null when the file is missing
+	std::shared_ptr<const ofJson> loadJson(const std::string &path) {
+		return load<ofJson>(path, "json", [](const std::string &p) {
+			return ofFile(p).exists() ? ofLoadJson(p) : ofJson();
+		});
+	}
+
+	// Replaces the view after a node rewrote the file itself, so other nodes
+	// get the new content without a reparse
+	template<typename T>
+	void publish(const std::string &path, const std::string &form, T value) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = entries.find(keyFor(path, form));
+		if(it == entries.end()) return;
+		it->second->value = std::shared_ptr<const T>(std::make_shared<T>(std::move(value)));
+		it->second->modified = modificationTime(path);
+		changedPaths.push_back(path);
+	}
+
+private:
+	using FileTime = std::filesystem::file_time_type;
+	static constexpr int WATCH_INTERVAL_MS = 1000;
+
+	struct Entry {
+		std::string path;
+		std::function<std::shared_ptr<const void>(const std::string &)> parse;  // set once
+		std::shared_ptr<const void> value;  // guarded by mutex
+		FileTime modified;                  // guarded by mutex
+	};
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::thread worker;
+	std::map<std::string, std::shared_ptr<Entry>> entries;
+	std::vector<std::string> changedPaths;
+	bool quit = false;
+	ofEventListener updateListener;
+
+	harmonyLibraryStore() {
+		updateListener = ofEvents().update.newListener([this](ofEventArgs &) {
+			notifyChanged();
+		}, OF_EVENT_ORDER_BEFORE_APP);
+	}
+
+	// Relative and absolute spellings of a data path name the same entry
+	static std::string keyFor(const std::string &path, const std::string &form) {
+		std::error_code ec;
+		std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+		return (ec ? path : canonical.string()) + "|" + form;
+	}
+
+	static FileTime modificationTime(const std::string &path) {
+		std::error_code ec;
+		FileTime t = std::filesystem::last_write_time(path, ec);
+		return ec ? FileTime::min() : t;
+	}
+
+	void notifyChanged() {
+		std::vector<std::string> paths;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if(changedPaths.empty()) return;
+			paths.swap(changedPaths);
+		}
+		std::sort(paths.begin(), paths.end());
+		paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+		for(auto &path : paths) ofNotifyEvent(changed, path);
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while(!quit) {
+			wake.wait_for(lock, std::chrono::milliseconds(WATCH_INTERVAL_MS));
+			if(quit) break;
+
+			// Drop views nobody holds any more; keep the rest to check
+			std::vector<std::pair<std::shared_ptr<Entry>, FileTime>> watched;
+			for(auto it = entries.begin(); it != entries.end();) {
+				if(it->second->value.use_count() == 1) {
+					it = entries.erase(it);
+				} else {
+					watched.emplace_back(it->second, it->second->modified);
+					it++;
+				}
+			}
+
+			lock.unlock();
+			for(auto &[entry, known] : watched) {
+				FileTime now = modificationTime(entry->path);
+				if(now == known) continue;
+				std::shared_ptr<const void> fresh = entry->parse(entry->path);
+				lock.lock();
+				// publish() may have installed a newer view meanwhile
+				bool swapped = entry->modified == known;
+				if(swapped) {
+					entry->value = std::move(fresh);
+					entry->modified = now;
+					changedPaths.push_back(entry->path);
+				}
+				lock.unlock();
+				if(swapped) ofLogNotice("harmonyLibraryStore") << "Reloaded " << entry->path;
+			}
+			lock.lock();
+		}
+	}
+};
+
+#endif /* harmonyLibraryStore_h */
@@ -3,6 +3,7 @@
 
 #include "ofxOceanodeNodeModel.h"
 #include "ofJson.h"
+#include "harmonyLibraryStore.h"
 
 class jazzStandards : public ofxOceanodeNodeModel {
 public:
@@ -61,6 +62,18 @@ public:
             listeners.push(selectedSong.newListener([this](int &i){
                 updateSong();
             }));
+            
+            // JazzStandards.json edited on disk: refresh the song list
+            listeners.push(harmonyLibraryStore::get().changed.newListener([this](string &path){
+                if(!harmonyLibraryStore::samePath(path, getDatabasePath())) return;
+                loadSongDatabase();
+                if(songTitles.empty()) {
+                    songTitles.push_back("No songs loaded");
+                }
+                selectedSong.setMax(songTitles.size()-1);
+                getOceanodeParameter(selectedSong).setDropdownOptions(songTitles);
+                updateSong();
+            }));
         }
     
 private:
@@ -84,16 +97,20 @@ private:
         
         ofEventListeners listeners;
         std::vector<string> songTitles;
-        ofJson songDatabase;
+        std::shared_ptr<const ofJson> songDatabase;  // shared with every node reading the file
+    
+    string getDatabasePath() const {
+        return ofToDataPath("Supercollider/Pitchclass/JazzStandards.json");
+    }
     
     void loadSongDatabase() {
-        string path = ofToDataPath("Supercollider/Pitchclass/JazzStandards.json");
-        ofFile file(path);
+        string path = getDatabasePath();
+        songDatabase = harmonyLibraryStore::get().loadJson(path);
         
-        if(file.exists()) {
-            songDatabase = ofLoadJson(path);
-            for(auto & song : songDatabase) {
-                songTitles.push_back(song["Title"].get<string>());
+        songTitles.clear();
+        if(!songDatabase->is_null()) {
+            for(auto & song : *songDatabase) {
+                songTitles.push_back(song.value("Title", string()));
             }
         } else {
             ofLogError("JazzStandards") << "Could not load database at: " << path;
@@ -137,9 +154,9 @@ private:
     }
     
     void updateSong() {
-            if(selectedSong < 0 || selectedSong >= songDatabase.size()) return;
+            if(selectedSong < 0 || selectedSong >= songDatabase->size()) return;
             
-            const auto& song = songDatabase[selectedSong];
+            const auto& song = (*songDatabase)[selectedSong];
             
             // Clear all outputs first
             for(int i = 0; i < 2; i++) {
@@ -152,20 +169,20 @@ private:
             }
             
             // Set basic info
-            timeSignature.set(song["TimeSignature"].get<string>());
-            composer.set(song["Composer"].get<string>());
+            timeSignature.set(song.value("TimeSignature", string()));
+            composer.set(song.value("Composer", string()));
             
-            float barLength = getBarLength(song["TimeSignature"].get<string>());
+            float barLength = getBarLength(song.value("TimeSignature", string()));
             
             // Process sections
             if(song.contains("Sections")) {
-                const auto& jsonSections = song["Sections"];
+                const auto& jsonSections = song.at("Sections");
                 for(size_t i = 0; i < std::min(size_t(2), jsonSections.size()); i++) {
                     const auto& section = jsonSections[i];
                     
                     // Process main segment
                     if(section.contains("MainSegment")) {
-                        auto [chords, timings] = parseChordString(section["MainSegment"]["Chords"], barLength);
+                        auto [chords, timings] = parseChordString(section.at("MainSegment").value("Chords", string()), barLength);
                         
                         string chordStr = "";
                         for(size_t j = 0; j < chords.size(); j++) {
@@ -179,14 +196,14 @@ private:
                     
                     // Set repeats if present
                     if(section.contains("Repeats")) {
-                        sections[i].repeats.set(section["Repeats"].get<int>());
+                        sections[i].repeats.set(section.at("Repeats").get<int>());
                     }
                     
                     // Process endings if present
                     if(section.contains("Endings") && i < 2) {
-                        const auto& jsonEndings = section["Endings"];
+                        const auto& jsonEndings = section.at("Endings");
                         for(size_t j = 0; j < std::min(size_t(1), jsonEndings.size()); j++) {
-                            auto [chords, timings] = parseChordString(jsonEndings[j]["Chords"], barLength);
+                            auto [chords, timings] = parseChordString(jsonEndings[j].value("Chords", string()), barLength);
                             
                             string chordStr = "";
                             for(size_t k = 0; k < chords.size(); k++) {
@@ -4,6 +4,7 @@
 #include "ofxOceanodeNodeModel.h"
 #include "ofxOceanodeShared.h"
 #include "imgui_internal.h"
+#include "sequencerContext.h"
 #include <random>
 
 class markovVector : public ofxOceanodeNodeModel {
@@ -133,6 +134,7 @@ private:
 	ofParameter<bool> noRepeats;
 	ofParameter<int> seed;
 	ofParameter<void> recalculate;
+	sequencerRng seedSource{this};  // per-calculation seeds when Seed is 0
 	ofParameter<vector<int>> output;
 	
 	vector<vector<float>> transitionMatrices;
@@ -211,8 +213,7 @@ private:
 		if(seed > 0) {
 			gen.seed(seed);
 		} else {
-			std::random_device rd;
-			gen.seed(rd());
+			gen.seed(seedSource());
 		}
 		
 		if(noRepeats) {
@@ -3,10 +3,13 @@
 
 #include "ofxOceanodeNodeModel.h"
 #include "ofxMidi.h"
-#include "ofThreadChannel.h"
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
-#include <deque>
+#include <mutex>
+#include <thread>
 
 /*
 	MIDI Clock Transport (thread-safe, tick-based BPM)
@@ -16,8 +19,123 @@
 	2) SPP handling with toggle for REAPER vs standard MIDI
 	3) "Clock Only Mode" for devices without transport signals
 	4) Configurable smoothing window size
+
+	The MIDI thread never blocks or allocates: tick timestamps go into a
+	fixed ring and the transport state is published through a seqlock,
+	both read lock-free by the main thread. Port enumeration runs on a
+	shared background thread (midiPortScanner).
 */
 
+// Tick timestamps (microseconds) written by the MIDI thread, read by the main
+// thread. The writer never waits: it overwrites the oldest slot, and the
+// reader re-checks the write count after copying to detect that.
+class midiTickRing {
+public:
+	static constexpr uint64_t CAPACITY = 256;  // power of two, > 2x max BPM Window
+
+	void push(uint64_t us) {
+		uint64_t n = written.load(std::memory_order_relaxed);
+		slots[n & (CAPACITY - 1)].store(us, std::memory_order_relaxed);
+		written.store(n + 1, std::memory_order_release);
+	}
+
+	// Forget the history for BPM purposes (SPP jump, continue, start)
+	void restart() {
+		validFrom.store(written.load(std::memory_order_relaxed), std::memory_order_release);
+	}
+
+	// Newest tick and the one up to maxTicks - 1 intervals before it. The
+	// average tick length over the window is (newest - oldest) / intervals,
+	// so the estimate is O(1) whatever the window size.
+	bool window(size_t maxTicks, uint64_t &oldest, uint64_t &newest, size_t &intervals) const {
+		maxTicks = std::min<uint64_t>(maxTicks, CAPACITY / 2);
+		for(;;) {
+			uint64_t n = written.load(std::memory_order_acquire);
+			uint64_t from = std::min(validFrom.load(std::memory_order_acquire), n);
+			uint64_t use = std::min<uint64_t>(maxTicks, n - from);
+			if(use < 2) return false;
+
+			newest = slots[(n - 1) & (CAPACITY - 1)].load(std::memory_order_relaxed);
+			oldest = slots[(n - use) & (CAPACITY - 1)].load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			// Slot n - use is reused once the writer reaches n - use + CAPACITY
+			if(written.load(std::memory_order_relaxed) - n <= CAPACITY - use) {
+				intervals = size_t(use - 1);
+				return true;
+			}
+		}
+	}
+
+private:
+	std::atomic<uint64_t> slots[CAPACITY] = {};
+	std::atomic<uint64_t> written{0};
+	std::atomic<uint64_t> validFrom{0};
+};
+
+// Process-wide MIDI input port list. Enumerating ports is slow on some
+// backends, so it runs once a second on a background thread shared by every
+// midiClockTransport; nodes only compare version() each frame.
+class midiPortScanner {
+public:
+	static midiPortScanner& get() {
+		static midiPortScanner instance;
+		return instance;
+	}
+
+	~midiPortScanner() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		wake.notify_all();
+		if(worker.joinable()) worker.join();
+	}
+
+	// Bumped whenever ports() changes
+	uint32_t version() const { return listVersion.load(std::memory_order_acquire); }
+
+	vector<string> ports() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return list;
+	}
+
+private:
+	static constexpr int SCAN_INTERVAL_MS = 1000;
+
+	ofxMidiIn scanner;  // constructor, then the worker thread only
+	mutable std::mutex mutex;
+	std::condition_variable wake;
+	std::thread worker;
+	vector<string> list;
+	std::atomic<uint32_t> listVersion{0};
+	bool quit = false;
+
+	midiPortScanner() {
+		// First scan is synchronous so setup() and preset recall see the ports
+		list = scanner.getInPortList();
+		listVersion = 1;
+		worker = std::thread([this]() { run(); });
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while(!quit) {
+			wake.wait_for(lock, std::chrono::milliseconds(SCAN_INTERVAL_MS));
+			if(quit) break;
+
+			lock.unlock();
+			vector<string> found = scanner.getInPortList();
+			lock.lock();
+
+			if(found != list) {
+				list = std::move(found);
+				listVersion++;
+			}
+		}
+	}
+};
+
 class midiClockTransport :
 	public ofxOceanodeNodeModel,
 	public ofxMidiListener {
@@ -28,7 +146,6 @@ public:
 
 	~midiClockTransport() override {
 		stopMidi();
-		snapToMain.close();
 	}
 
 	void setup() override {
@@ -99,7 +216,6 @@ public:
 		resetMainThreadState();
 		resetMidiThreadState();
         
-        oldNumPorts = 0;
         unavailablePort = "";
 	}
 
@@ -124,13 +240,7 @@ public:
 			tickCount_midi++;
 			
 			// Store tick timestamp for BPM calculation (microseconds)
-			tickTimestamps_midi.push_back(now);
-			
-			// Trim to max window size (keep some extra for flexibility)
-			const size_t maxSize = 128;
-			while(tickTimestamps_midi.size() > maxSize) {
-				tickTimestamps_midi.pop_front();
-			}
+			tickRing.push(now);
 
 			lastClockMs_midi = now / 1000;  // Keep ms version for other uses
 			stopped_midi = false;
@@ -172,7 +282,7 @@ public:
 				lastSpp_midi = (static_cast<int>(byte1) << 7) | static_cast<int>(byte0);
 				
 				// Clear tick timestamps on jump (they're no longer valid for BPM calc)
-				tickTimestamps_midi.clear();
+				tickRing.restart();
 
 				pushSnapshot(ofGetElapsedTimeMicros());
 			}
@@ -195,7 +305,7 @@ public:
 			jumpCounter_midi++;
 			
 			// Clear tick timestamps on continue (timing discontinuity)
-			tickTimestamps_midi.clear();
+			tickRing.restart();
 
 			pushSnapshot(ofGetElapsedTimeMicros());
 		}
@@ -213,13 +323,10 @@ public:
 
 	void update(ofEventArgs &args) override {
         //Check new connected devices
-        scanMidiPorts();
+        if(midiPortScanner::get().version() != portListVersion) scanMidiPorts();
         
 		ClockSnapshot s;
-		bool got = false;
-		while(snapToMain.tryReceive(s)) {
-			got = true;
-		}
+		const bool got = readSnapshot(s);
 
 		if(jumpTrigFramesRemaining > 0){
 			jumpTrigFramesRemaining--;
@@ -261,30 +368,22 @@ public:
 		const int windowSize = bpmWindowSize.get();
 		const int decimals = bpmDecimals.get();
 		
-		if(s.playing && s.tickTimestamps.size() >= 2) {
-			// Use up to windowSize ticks
-			const size_t available = s.tickTimestamps.size();
-			const size_t useCount = std::min(static_cast<size_t>(windowSize), available);
+		uint64_t oldestUs = 0, newestUs = 0;
+		size_t tickIntervals = 0;  // N timestamps = N-1 intervals
+		
+		if(s.playing && tickRing.window(static_cast<size_t>(windowSize), oldestUs, newestUs, tickIntervals)) {
+			const uint64_t durationUs = newestUs - oldestUs;
 			
-			if(useCount >= 2) {
-				// Get timestamps from the end of the deque (most recent)
-				const uint64_t newestUs = s.tickTimestamps.back();
-				const uint64_t oldestUs = s.tickTimestamps[available - useCount];
+			if(durationUs > 0 && tickIntervals > 0) {
+				// Average microseconds per tick
+				const double avgUsPerTick = static_cast<double>(durationUs) / static_cast<double>(tickIntervals);
 				
-				const uint64_t durationUs = newestUs - oldestUs;
-				const size_t tickIntervals = useCount - 1;  // N timestamps = N-1 intervals
+				// BPM = 60000000 / (us_per_tick * 24)
+				const double instantBpm = 60000000.0 / (avgUsPerTick * 24.0);
 				
-				if(durationUs > 0 && tickIntervals > 0) {
-					// Average microseconds per tick
-					const double avgUsPerTick = static_cast<double>(durationUs) / static_cast<double>(tickIntervals);
-					
-					// BPM = 60000000 / (us_per_tick * 24)
-					const double instantBpm = 60000000.0 / (avgUsPerTick * 24.0);
-					
-					if(std::isfinite(instantBpm) && instantBpm >= 20.0 && instantBpm <= 400.0) {
-						// Light smoothing to avoid micro-jitter
-						bpmSmooth_main = bpmSmooth_main * 0.8 + instantBpm * 0.2;
-					}
+				if(std::isfinite(instantBpm) && instantBpm >= 20.0 && instantBpm <= 400.0) {
+					// Light smoothing to avoid micro-jitter
+					bpmSmooth_main = bpmSmooth_main * 0.8 + instantBpm * 0.2;
 				}
 			}
 		}
@@ -330,7 +429,6 @@ public:
 
 private:
 	struct ClockSnapshot {
-		uint64_t ms = 0;
 		int tickCount = 0;
 
 		bool playing = false;
@@ -340,14 +438,20 @@ private:
 		uint32_t startCounter = 0;
 		uint32_t stopCounter = 0;
 		uint32_t contCounter = 0;
-
-		int lastSpp = -1;
-		
-		// Tick timestamps for BPM calculation (copied from MIDI thread)
-		std::deque<uint64_t> tickTimestamps;
 	};
 
-	ofThreadChannel<ClockSnapshot> snapToMain;
+	/* ================= SHARED (MIDI THREAD -> MAIN THREAD) ================= */
+	// Latest ClockSnapshot behind a seqlock: odd while the MIDI thread writes
+	std::atomic<uint32_t> snapSeq{0};
+	std::atomic<int>      snapTickCount{0};
+	std::atomic<bool>     snapPlaying{false};
+	std::atomic<bool>     snapStopped{true};
+	std::atomic<uint32_t> snapJumpCounter{0};
+	std::atomic<uint32_t> snapStartCounter{0};
+	std::atomic<uint32_t> snapStopCounter{0};
+	std::atomic<uint32_t> snapContCounter{0};
+
+	midiTickRing tickRing;
 
 	/* ================= MIDI THREAD STATE ================= */
 	uint64_t lastClockMs_midi = 0;
@@ -362,11 +466,9 @@ private:
 	uint32_t contCounter_midi = 0;
 
 	int lastSpp_midi = -1;
-	
-	// Tick timestamps for BPM calculation
-	std::deque<uint64_t> tickTimestamps_midi;
 
 	/* ================= MAIN THREAD STATE ================= */
+	uint32_t lastSnapSeq_main = 0;
 	uint32_t lastJumpCounter_main = 0;
 	uint32_t lastStartCounter_main = 0;
 	uint32_t lastStopCounter_main  = 0;
@@ -376,28 +478,42 @@ private:
 	
 	int jumpTrigFramesRemaining = 0;
 
-	void pushSnapshot(uint64_t nowMs) {
-		ClockSnapshot old;
-		while(snapToMain.tryReceive(old)) {}
-
-		ClockSnapshot s;
-		s.ms = nowMs;
-		s.tickCount = tickCount_midi;
-
-		s.playing = playing_midi;
-		s.stopped = stopped_midi;
-
-		s.jumpCounter = jumpCounter_midi;
-		s.startCounter = startCounter_midi;
-		s.stopCounter = stopCounter_midi;
-		s.contCounter = contCounter_midi;
-
-		s.lastSpp = lastSpp_midi;
-		
-		// Copy tick timestamps for BPM calculation on main thread
-		s.tickTimestamps = tickTimestamps_midi;
+	// MIDI thread: publish the current state, replacing the previous one
+	void pushSnapshot(uint64_t nowUs) {
+		const uint32_t seq = snapSeq.load(std::memory_order_relaxed);
+		snapSeq.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		snapTickCount.store(tickCount_midi, std::memory_order_relaxed);
+		snapPlaying.store(playing_midi, std::memory_order_relaxed);
+		snapStopped.store(stopped_midi, std::memory_order_relaxed);
+		snapJumpCounter.store(jumpCounter_midi, std::memory_order_relaxed);
+		snapStartCounter.store(startCounter_midi, std::memory_order_relaxed);
+		snapStopCounter.store(stopCounter_midi, std::memory_order_relaxed);
+		snapContCounter.store(contCounter_midi, std::memory_order_relaxed);
+
+		snapSeq.store(seq + 2, std::memory_order_release);
+	}
 
-		snapToMain.send(s);
+	// Main thread: latest consistent state; false if nothing new was pushed
+	bool readSnapshot(ClockSnapshot &s) {
+		uint32_t before, after;
+		do {
+			before = snapSeq.load(std::memory_order_acquire);
+			s.tickCount    = snapTickCount.load(std::memory_order_relaxed);
+			s.playing      = snapPlaying.load(std::memory_order_relaxed);
+			s.stopped      = snapStopped.load(std::memory_order_relaxed);
+			s.jumpCounter  = snapJumpCounter.load(std::memory_order_relaxed);
+			s.startCounter = snapStartCounter.load(std::memory_order_relaxed);
+			s.stopCounter  = snapStopCounter.load(std::memory_order_relaxed);
+			s.contCounter  = snapContCounter.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after = snapSeq.load(std::memory_order_relaxed);
+		} while((before & 1) || before != after);
+
+		if(before == lastSnapSeq_main) return false;
+		lastSnapSeq_main = before;
+		return true;
 	}
 
 	/* ================= MIDI MANAGEMENT ================= */
@@ -453,7 +569,7 @@ private:
 
 		lastSpp_midi = -1;
 		
-		tickTimestamps_midi.clear();
+		tickRing.restart();
 	}
 
 	void resetMainThreadState() {
@@ -468,8 +584,8 @@ private:
 		timeSeconds = 0.f;
 		bpm = 120.f;
 
-		ClockSnapshot old;
-		while(snapToMain.tryReceive(old)) {}
+		// Ignore whatever was published before the reset
+		lastSnapSeq_main = snapSeq.load(std::memory_order_acquire) & ~1u;
 
 		lastJumpCounter_main = 0;
 		lastStartCounter_main = 0;
@@ -482,14 +598,12 @@ private:
 	}
         
     void scanMidiPorts(){
-        int numPorts = midiIn.getNumInPorts();
-        if(oldNumPorts == numPorts) return;
+        auto &scanner = midiPortScanner::get();
+        portListVersion = scanner.version();
+        vector<string> ports = scanner.ports();
         string selectedPortName = midiPortsList[midiPort];
         midiPortsList = {"None"};
-        midiPortsList.resize(1+numPorts);
-        for(int i = 0; i < numPorts; i++){
-            midiPortsList[i+1] = midiIn.getInPortList()[i];
-        }
+        midiPortsList.insert(midiPortsList.end(), ports.begin(), ports.end());
         if(midiPort >= midiPortsList.size() || selectedPortName != midiPortsList[midiPort]){
             midiPort = 0;
             unavailablePort = selectedPortName;
@@ -505,7 +619,6 @@ private:
                 unavailablePort = "";
             }
         }
-        oldNumPorts = numPorts;
     }
 
 	/* -------- MIDI -------- */
@@ -534,7 +647,7 @@ private:
 	ofEventListeners listeners;
         
     vector<string> midiPortsList;
-    int oldNumPorts;
+    uint32_t portListVersion = 0;  // midiPortScanner::version() last applied
     string unavailablePort;
 };
 
@@ -18,6 +18,7 @@ public:
         addParameter(numColors.set("numColors", 4, 1, 16));
         addParameter(stability.set("stability", 0.85f, 0.0f, 0.99f));
         addParameter(analyzeEvery.set("analyzeEvery", 1, 1, 30));
+        addParameter(histogramKMeans.set("histogramKMeans", false));
         addOutputParameter(mixOutput.set("mix", nullptr));
 
         updateColorOutputs();
@@ -92,11 +93,14 @@ public:
 private:
     static constexpr int MAX_PALETTE_COLORS = 16;
     static constexpr int MAX_ANALYSIS_SIDE = 64;
+    static constexpr int HISTOGRAM_SIDE = 32;
+    static constexpr int MAX_KMEANS_ITERATIONS = 8;
 
     ofParameter<ofTexture*> input;
     ofParameter<int> numColors;
     ofParameter<float> stability;
     ofParameter<int> analyzeEvery;
+    ofParameter<bool> histogramKMeans;
     ofParameter<ofTexture*> mixOutput;
     std::vector<ofParameter<ofTexture*>> colorOutputs;
 
@@ -110,6 +114,16 @@ private:
     bool paletteInitialized = false;
     int frameCounter = 0;
 
+    // Histogram k-means scratch: samples are binned into HISTOGRAM_SIDE^3
+    // color cells and clustered as (mean color, sample count) points
+    struct ColorBin {
+        glm::vec3 sum = glm::vec3(0.0f);
+        int count = 0;
+    };
+    std::vector<int> histogramSlots; // bin -> index into colorBins, or -1
+    std::vector<int> usedBins;
+    std::vector<ColorBin> colorBins;
+
     ofEventListener numColorsListener;
 
     void setupShader() {
@@ -240,7 +254,7 @@ private:
         analysisFbo.getTexture().readToPixels(analysisPixels);
     }
 
-    std::vector<glm::vec3> extractPaletteFromAnalysis() const {
+    std::vector<glm::vec3> extractPaletteFromAnalysis() {
         std::vector<glm::vec3> sampleColors;
         const int channels = analysisPixels.getNumChannels();
         const int totalPixels = analysisPixels.getWidth() * analysisPixels.getHeight();
@@ -261,6 +275,7 @@ private:
         if(sampleColors.empty()) return {};
 
         const int paletteSize = std::min(numColors.get(), static_cast<int>(sampleColors.size()));
+        if(histogramKMeans) return buildPaletteFromHistogram(sampleColors, paletteSize);
         return buildPalette(sampleColors, paletteSize);
     }
 
@@ -402,6 +417,81 @@ private:
         return sortedCenters;
     }
 
+    // Same clustering as buildPalette(), but over the non-empty histogram bins
+    // weighted by their sample count, starting from the previous palette when
+    // there is one and stopping once no center moves
+    std::vector<glm::vec3> buildPaletteFromHistogram(const std::vector<glm::vec3> &samples, int paletteSize) {
+        histogramSlots.resize(HISTOGRAM_SIDE * HISTOGRAM_SIDE * HISTOGRAM_SIDE, -1);
+        colorBins.clear();
+        usedBins.clear();
+
+        auto binCoord = [](float value) {
+            return std::min(HISTOGRAM_SIDE - 1, std::max(0, static_cast<int>(value * HISTOGRAM_SIDE)));
+        };
+        for(const glm::vec3 &sample : samples) {
+            const int bin = (binCoord(sample.r) * HISTOGRAM_SIDE + binCoord(sample.g)) * HISTOGRAM_SIDE + binCoord(sample.b);
+            int &slot = histogramSlots[bin];
+            if(slot < 0) {
+                slot = static_cast<int>(colorBins.size());
+                colorBins.emplace_back();
+                usedBins.push_back(bin);
+            }
+            colorBins[slot].sum += sample;
+            colorBins[slot].count++;
+        }
+        // Only the touched bins are reset, so the next frame starts clean
+        for(int bin : usedBins) histogramSlots[bin] = -1;
+
+        std::vector<glm::vec3> points;
+        std::vector<float> weights;
+        points.reserve(colorBins.size());
+        weights.reserve(colorBins.size());
+        for(const ColorBin &bin : colorBins) {
+            points.push_back(bin.sum / static_cast<float>(bin.count));
+            weights.push_back(static_cast<float>(bin.count));
+        }
+
+        std::vector<glm::vec3> centers;
+        if(paletteInitialized && static_cast<int>(cachedPalette.size()) == paletteSize) {
+            centers = cachedPalette;
+        } else {
+            centers.reserve(paletteSize);
+            const float denominator = std::max(1, paletteSize - 1);
+            for(int i = 0; i < paletteSize; i++) {
+                const int sampleIndex = static_cast<int>(std::round((samples.size() - 1) * (i / denominator)));
+                centers.push_back(samples[sampleIndex]);
+            }
+        }
+
+        std::vector<glm::vec3> sums(paletteSize);
+        std::vector<float> totals(paletteSize);
+        for(int iteration = 0; iteration < MAX_KMEANS_ITERATIONS; iteration++) {
+            std::fill(sums.begin(), sums.end(), glm::vec3(0.0f));
+            std::fill(totals.begin(), totals.end(), 0.0f);
+
+            for(size_t i = 0; i < points.size(); i++) {
+                const int closestIndex = findClosestPaletteColor(points[i], centers);
+                sums[closestIndex] += points[i] * weights[i];
+                totals[closestIndex] += weights[i];
+            }
+
+            float maxShift = 0.0f;
+            for(int i = 0; i < paletteSize; i++) {
+                if(totals[i] <= 0.0f) continue;
+                const glm::vec3 center = sums[i] / totals[i];
+                const glm::vec3 diff = center - centers[i];
+                maxShift = std::max(maxShift, glm::dot(diff, diff));
+                centers[i] = center;
+            }
+            if(maxShift < 1e-8f) break;
+        }
+
+        std::sort(centers.begin(), centers.end(), [](const glm::vec3 &a, const glm::vec3 &b) {
+            return luminance(a) < luminance(b);
+        });
+        return centers;
+    }
+
     static int findClosestPaletteColor(const glm::vec3 &color, const std::vector<glm::vec3> &palette) {
         int bestIndex = 0;
         float bestDistance = std::numeric_limits<float>::max();
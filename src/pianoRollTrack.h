@@ -5,10 +5,13 @@
 #include "ofxOceanodeShared.h"
 #include "imgui.h"
 #include "ppqTimeline.h"
+#include "sequencerContext.h"
 #include "transportTrack.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <map>
+#include <numeric>
 #include <set>
 
 struct MidiNote {
@@ -28,6 +31,85 @@ struct MidiNote {
 	}
 };
 
+// Interval index over a track's notes: positions are the notes sorted by
+// (start, pitch, index), with a max-end segment tree over that order and a
+// second order by end.
+// Notes sounding at a beat come out in O(log n + k), ascending by position;
+// notes starting or ending inside a window in O(log n + k).
+class noteIntervalIndex {
+public:
+	void build(const std::vector<MidiNote>& notes) {
+		size_t n = notes.size();
+		order.resize(n);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+			if(notes[a].startBeat != notes[b].startBeat) return notes[a].startBeat < notes[b].startBeat;
+			if(notes[a].pitch != notes[b].pitch) return notes[a].pitch < notes[b].pitch;
+			return a < b;
+		});
+		starts.resize(n);
+		ends.resize(n);
+		for(size_t p = 0; p < n; p++) {
+			starts[p] = notes[order[p]].startBeat;
+			ends[p]   = notes[order[p]].endBeat();
+		}
+
+		endOrder.resize(n);
+		std::iota(endOrder.begin(), endOrder.end(), 0);
+		std::stable_sort(endOrder.begin(), endOrder.end(), [&](int a, int b) { return ends[a] < ends[b]; });
+		sortedEnds.resize(n);
+		for(size_t i = 0; i < n; i++) sortedEnds[i] = ends[endOrder[i]];
+
+		leaves = 1;
+		while(leaves < n) leaves <<= 1;
+		maxEnd.assign(2 * leaves, -std::numeric_limits<double>::infinity());
+		for(size_t p = 0; p < n; p++) maxEnd[leaves + p] = ends[p];
+		for(size_t i = leaves - 1; i >= 1; i--) maxEnd[i] = std::max(maxEnd[2 * i], maxEnd[2 * i + 1]);
+	}
+
+	size_t size() const { return starts.size(); }
+	int    note(size_t p)  const { return order[p]; }
+	double start(size_t p) const { return starts[p]; }
+	double end(size_t p)   const { return ends[p]; }
+
+	// Number of positions with start <= beat / start < beat
+	size_t startsUpTo(double beat) const {
+		return std::upper_bound(starts.begin(), starts.end(), beat) - starts.begin();
+	}
+	size_t startsBefore(double beat) const {
+		return std::lower_bound(starts.begin(), starts.end(), beat) - starts.begin();
+	}
+
+	// Appends the positions p < count with end(p) > beat
+	void overlapping(size_t count, double beat, std::vector<int>& out) const {
+		if(count > 0) collect(1, 0, leaves, count, beat, out);
+	}
+
+	// Calls fn(p) for every position with end(p) in [from, to)
+	template<typename Fn>
+	void forEndsIn(double from, double to, Fn fn) const {
+		auto it = std::lower_bound(sortedEnds.begin(), sortedEnds.end(), from);
+		for(size_t i = it - sortedEnds.begin(); i < sortedEnds.size() && sortedEnds[i] < to; i++)
+			fn((size_t)endOrder[i]);
+	}
+
+private:
+	std::vector<int>    order;      // position -> index in notes
+	std::vector<double> starts, ends;
+	std::vector<int>    endOrder;   // positions sorted by end
+	std::vector<double> sortedEnds;
+	std::vector<double> maxEnd;     // segment tree, leaves at [leaves, 2 * leaves)
+	size_t leaves = 1;
+
+	void collect(size_t node, size_t lo, size_t hi, size_t count, double beat, std::vector<int>& out) const {
+		if(lo >= count || maxEnd[node] <= beat) return;
+		if(hi - lo == 1) { out.push_back((int)lo); return; }
+		size_t mid = (lo + hi) / 2;
+		collect(2 * node, lo, mid, count, beat, out);
+		collect(2 * node + 1, mid, hi, count, beat, out);
+	}
+};
+
 class pianoRollTrack : public ofxOceanodeNodeModel, public transportTrack {
 public:
 	pianoRollTrack() : ofxOceanodeNodeModel("Piano Roll Track") {
@@ -99,39 +181,57 @@ public:
 		if(localBeat < 0.0) {
 			pitchesOutput = {}; velocitiesOutput = {}; gatesOutput = {};
 			numActiveOutput = 0;
-			prevActiveNotes.clear(); gateRollResults.clear();
+			gateRollResults.clear();
+			cursorValid = false;
 			return;
 		}
 
+		// ── Active notes: forward cursor while playback is monotonic, interval
+		// query on wraps, jumps and edits ─────────────────────────────────────
+		ensureNoteIndex();
+		size_t reach = noteIndex.startsUpTo(localBeat);
+		if(cursorValid && localBeat >= cursorBeat && reach - cursorPos <= MAX_CURSOR_STEP) {
+			activeSlots.erase(std::remove_if(activeSlots.begin(), activeSlots.end(),
+				[&](int p) { return noteIndex.end(p) <= localBeat; }), activeSlots.end());
+			for(size_t p = cursorPos; p < reach; p++)
+				if(noteIndex.end(p) > localBeat) activeSlots.push_back((int)p);
+		} else {
+			activeSlots.clear();
+			noteIndex.overlapping(reach, localBeat, activeSlots);
+		}
+		cursorPos   = reach;
+		cursorBeat  = localBeat;
+		cursorValid = true;
+
 		// ── Probability gate: roll once per note onset, hold for note duration ──
-		std::set<NoteKey> currentActive;
-		for(const auto& n : notes)
-			if(localBeat >= n.startBeat && localBeat < n.endBeat())
-				currentActive.insert({n.startBeat, n.pitch});
-
-		for(const auto& key : currentActive) {
-			if(!prevActiveNotes.count(key)) {
-				// New onset — find the note and roll
-				float prob = 1.0f;
-				for(const auto& n : notes)
-					if(n.startBeat == key.first && n.pitch == key.second)
-						{ prob = n.probability; break; }
-				gateRollResults[key] = (ofRandom(1.0f) < prob);
-			}
+		// Positions ascend by (start, pitch, index), so new onsets roll in key
+		// order with the first note of a duplicated key deciding, as before
+		activeKeys.clear();
+		for(int p : activeSlots) {
+			const MidiNote& n = notes[noteIndex.note(p)];
+			activeKeys.push_back({n.startBeat, n.pitch});
 		}
-		for(auto it = gateRollResults.begin(); it != gateRollResults.end(); )
-			it = currentActive.count(it->first) ? std::next(it) : gateRollResults.erase(it);
-		prevActiveNotes = currentActive;
+		std::sort(activeKeys.begin(), activeKeys.end());
+		for(int p : activeSlots) {
+			const MidiNote& n = notes[noteIndex.note(p)];
+			NoteKey key{n.startBeat, n.pitch};
+			if(!gateRollResults.count(key)) gateRollResults[key] = (rng.uniform(1.0f) < n.probability); // onset
+		}
+		for(auto it = gateRollResults.begin(); it != gateRollResults.end(); ) // offsets
+			it = std::binary_search(activeKeys.begin(), activeKeys.end(), it->first) ? std::next(it) : gateRollResults.erase(it);
+
+		// Outputs follow the notes vector, not the index order
+		activeNotes.clear();
+		for(int p : activeSlots) activeNotes.push_back(noteIndex.note(p));
+		std::sort(activeNotes.begin(), activeNotes.end());
 
 		vector<float> ap, av, ag;
-		for(const auto& n : notes) {
-			if(localBeat >= n.startBeat && localBeat < n.endBeat()) {
-				NoteKey key{n.startBeat, n.pitch};
-				if(gateRollResults.count(key) && gateRollResults.at(key)) {
-					ap.push_back(n.pitch);
-					av.push_back(n.velocity);
-					ag.push_back(1.0f);
-				}
+		for(int i : activeNotes) {
+			const MidiNote& n = notes[i];
+			if(gateRollResults.at({n.startBeat, n.pitch})) {
+				ap.push_back(n.pitch);
+				av.push_back(n.velocity);
+				ag.push_back(1.0f);
 			}
 		}
 		pitchesOutput    = ap;
@@ -147,6 +247,60 @@ public:
 	bool   isCollapsed() const override { return collapsed; }
 	void   setCollapsed(bool c) override { collapsed = c; }
 
+	// Lookahead events — notes are in clip-local beats, so each clip pass maps
+	// them to global beats. The probability gate is rolled per scheduled onset.
+	void collectEvents(double beatFrom, double beatTo, std::vector<transportEvent>& out) override {
+		ensureNoteIndex();
+		auto emit = [&](size_t p, double beat, bool on) {
+			const MidiNote& n = notes[noteIndex.note(p)];
+			NoteKey key{n.startBeat, n.pitch};
+			if(on) {
+				if(rng.uniform(1.0f) >= n.probability) return;
+				scheduledOpenNotes.insert(key);
+			} else if(!scheduledOpenNotes.erase(key)) {
+				return;
+			}
+			transportEvent e;
+			e.beat  = beat;
+			e.type  = on ? transportEvent::NoteOn : transportEvent::NoteOff;
+			e.index = n.pitch;
+			e.value = on ? n.velocity : 0.f;
+			out.push_back(e);
+		};
+		forEachClipPass(beatFrom, beatTo, [&](double base, double limit) {
+			double len = limit - base;
+			double lo  = beatFrom - base;
+			double hi  = beatTo - base;
+			// Onsets: notes already sounding at local 0 start with the pass
+			if(lo <= 0.0 && hi > 0.0) {
+				eventScratch.clear();
+				noteIndex.overlapping(noteIndex.startsBefore(0.0), 0.0, eventScratch);
+				for(int p : eventScratch) emit(p, base, true);
+			}
+			size_t p1 = noteIndex.startsBefore(std::min(hi, len));
+			for(size_t p = noteIndex.startsBefore(std::max(lo, 0.0)); p < p1; p++)
+				emit(p, base + noteIndex.start(p), true);
+			// Offsets: natural ends inside the pass, then notes cut at the pass limit
+			noteIndex.forEndsIn(lo, std::min(hi, std::nextafter(len, std::numeric_limits<double>::infinity())),
+				[&](size_t p) { emit(p, base + noteIndex.end(p), false); });
+			if(lo <= len && hi > len) {
+				eventScratch.clear();
+				noteIndex.overlapping(noteIndex.startsBefore(len), len, eventScratch);
+				for(int p : eventScratch) emit(p, limit, false);
+			}
+		});
+	}
+
+	void flushEvents(double beat, std::vector<transportEvent>& out) override {
+		for(const auto& key : scheduledOpenNotes) {
+			transportEvent e;
+			e.beat = beat; e.type = transportEvent::NoteOff;
+			e.index = key.second; e.value = 0.f;
+			out.push_back(e);
+		}
+		scheduledOpenNotes.clear();
+	}
+
 	// Clip window accessors (used by trackScheduler)
 	bool   hasClipWindow()        const override { return true; }
 	double getClipStart()         const override { return clipStart.get(); }
@@ -170,6 +324,7 @@ public:
 			notes[i].startBeat = stretchSnapshot[i].startBeat * factor;
 			notes[i].length    = stretchSnapshot[i].length    * factor;
 		}
+		noteIndexDirty = true;
 	}
 
 	// Mini content rendering for trackScheduler
@@ -767,6 +922,7 @@ public:
 				double minLen = gridTicks > 0 ? gridTicks/24.0 : 0.0625;
 				double newLen = std::max(newEnd - notes[resizeNoteIdx].startBeat, minLen);
 				notes[resizeNoteIdx].length = (float)newLen;
+				noteIndexDirty = true;
 			}
 			else if(isDraggingNote && !selectedNotes.empty()) {
 				// Delta in global beats == delta in local beats (cs cancels)
@@ -787,6 +943,7 @@ public:
 						notes[idx].pitch     = ofClamp(noteDragStates[j].origPitch + dp, 0, 127);
 						j++;
 					}
+					noteIndexDirty = true;
 				}
 			}
 			else if(isDraggingVelocity && velDragNote >= 0 &&
@@ -833,6 +990,7 @@ public:
 					copyBuffer.clear();
 				}
 				std::sort(notes.begin(), notes.end());
+				noteIndexDirty = true;
 				isDraggingNote = false;
 				noteDragStates.clear();
 			}
@@ -849,6 +1007,7 @@ public:
 					nw.velocity  = 0.8f;
 					notes.push_back(nw);
 					std::sort(notes.begin(), notes.end());
+					noteIndexDirty = true;
 				}
 				isCreatingNote = false;
 			}
@@ -867,6 +1026,7 @@ public:
 			for(int idx : toDelete)
 				notes.erase(notes.begin() + idx);
 			selectedNotes.clear();
+			noteIndexDirty = true;
 		}
 
 		// Right-click delete
@@ -882,6 +1042,7 @@ public:
 					   mouse.y >= y1 && mouse.y < y2) {
 						selectedNotes.erase(i);
 						notes.erase(notes.begin() + i);
+						noteIndexDirty = true;
 						std::set<int> fixed;
 						for(int s : selectedNotes) fixed.insert(s > i ? s-1 : s);
 						selectedNotes = fixed;
@@ -894,6 +1055,7 @@ public:
 					if(std::abs(mouse.x - vx) <= VEL_HIT_ZONE) {
 						selectedNotes.erase(i);
 						notes.erase(notes.begin() + i);
+						noteIndexDirty = true;
 						std::set<int> fixed;
 						for(int s : selectedNotes) fixed.insert(s > i ? s-1 : s);
 						selectedNotes = fixed;
@@ -927,6 +1089,7 @@ public:
 					notes.push_back(n);
 				}
 			}
+			noteIndexDirty = true;
 		}
 		if(json.count("trackHeight")) trackHeight = ofClamp((float)json["trackHeight"], MIN_H, MAX_H);
 		if(json.count("collapsed"))   collapsed = json["collapsed"];
@@ -948,6 +1111,25 @@ private:
 
 	ppqTimeline*              currentTimeline = nullptr;
 	std::vector<MidiNote>     notes;
+
+	// Interval index over notes, rebuilt lazily after edits
+	noteIntervalIndex         noteIndex;
+	bool                      noteIndexDirty = true;
+	static constexpr size_t   MAX_CURSOR_STEP = 64; // more new onsets than this → query instead
+	bool                      cursorValid = false;
+	double                    cursorBeat  = 0.0;
+	size_t                    cursorPos   = 0;   // first position not yet started at cursorBeat
+	std::vector<int>          activeSlots;       // sounding positions, ascending
+	std::vector<std::pair<double, int>> activeKeys;
+	std::vector<int>          activeNotes;       // sounding note indices, ascending
+	std::vector<int>          eventScratch;
+
+	void ensureNoteIndex() {
+		if(!noteIndexDirty) return;
+		noteIndex.build(notes);
+		noteIndexDirty = false;
+		cursorValid = false;
+	}
 	struct NoteSnapshot { double startBeat; float length; };
 	std::vector<NoteSnapshot> stretchSnapshot;
 	std::vector<std::string>  timelineOptions;
@@ -988,8 +1170,9 @@ private:
 
 	// Gate probability roll state
 	using NoteKey = std::pair<double, int>;
-	std::map<NoteKey, bool> gateRollResults;
-	std::set<NoteKey>       prevActiveNotes;
+	std::map<NoteKey, bool> gateRollResults;    // keyed by the notes currently sounding
+	std::set<NoteKey>       scheduledOpenNotes; // note-ons delivered by collectEvents, awaiting their off
+	sequencerRng            rng{this};          // reseeded with offline renders
 
 	// Rubber-band selection
 	bool  isRubberBanding = false;
@@ -0,0 +1,150 @@
+#ifndef pitchClassHistogram_h
+#define pitchClassHistogram_h
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Exponentially decaying 12-bin pitch-class histogram with running
+// Krumhansl-Kessler key correlations for the 24 major / minor keys.
+//
+// Bins are kept in a rescaled domain: decay() only multiplies a common scale
+// factor, and add() deposits weight / scale into one bin, so both are O(1)
+// whatever the window holds. The correlation of the histogram with a key
+// profile is scale-invariant, so each key keeps a running dot product with its
+// mean-centred profile (24 multiply-adds per add()) and keyScore() is the
+// Pearson r of the two, without touching the bins. When the scale gets tiny the
+// bins are folded back and the sums recomputed exactly, which also clears any
+// accumulated rounding.
+class pitchClassHistogram {
+public:
+	static constexpr int NUM_KEYS = 24;  // 0-11 major on C..B, 12-23 minor
+
+	pitchClassHistogram() { clear(); }
+
+	void clear() {
+		bins.fill(0.0);
+		dots.fill(0.0);
+		sum = 0.0;
+		sumSq = 0.0;
+		scale = 1.0;
+	}
+
+	// Adds `weight` to pitch class pc (0-11)
+	void add(int pc, double weight) {
+		if(weight <= 0.0) return;
+		double d = weight / scale;
+		double &b = bins[pc];
+		sumSq += d * (2.0 * b + d);
+		b += d;
+		sum += d;
+		const std::array<double, NUM_KEYS> &row = profiles().byPitchClass[pc];
+		for(int k = 0; k < NUM_KEYS; k++) dots[k] += d * row[k];
+	}
+
+	// Multiplies every bin by factor (0-1], e.g. exp2(-dt / halfLife)
+	void decay(double factor) {
+		if(factor >= 1.0) return;
+		if(factor <= 0.0) {
+			clear();
+			return;
+		}
+		scale *= factor;
+		if(scale < RESCALE_BELOW) rebase();
+	}
+
+	double bin(int pc) const { return bins[pc] * scale; }
+	double total() const { return sum * scale; }
+
+	// Pearson correlation with the key's profile, -1..1; 0 while the
+	// histogram is empty or flat
+	double keyScore(int key) const {
+		double spread = sumSq - sum * sum / 12.0;
+		if(spread <= sumSq * 1e-12) return 0.0;
+		return dots[key] / std::sqrt(spread * profiles().norm[key]);
+	}
+
+	// Highest-scoring key (the histogram's spread is common to all of them)
+	int bestKey() const {
+		int best = 0;
+		double bestValue = dots[0] / std::sqrt(profiles().norm[0]);
+		for(int k = 1; k < NUM_KEYS; k++) {
+			double value = dots[k] / std::sqrt(profiles().norm[k]);
+			if(value > bestValue) {
+				best = k;
+				bestValue = value;
+			}
+		}
+		return best;
+	}
+
+	// Pitch classes holding at least `fraction` of the largest bin
+	uint16_t maskAbove(double fraction) const {
+		double peak = 0.0;
+		for(double b : bins) peak = std::max(peak, b);
+		if(peak <= 0.0) return 0;
+		uint16_t mask = 0;
+		for(int pc = 0; pc < 12; pc++) {
+			if(bins[pc] > 0.0 && bins[pc] >= peak * fraction) mask |= uint16_t(1u << pc);
+		}
+		return mask;
+	}
+
+private:
+	static constexpr double RESCALE_BELOW = 1e-30;
+
+	struct Profiles {
+		// Mean-centred profile value of pitch class pc in key k
+		std::array<std::array<double, NUM_KEYS>, 12> byPitchClass;
+		// Sum of squares of each centred profile
+		std::array<double, NUM_KEYS> norm;
+	};
+
+	static const Profiles& profiles() {
+		static const Profiles p = [] {
+			// Krumhansl & Kessler (1982) probe-tone ratings, tonic first
+			const double major[12] = {6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88};
+			const double minor[12] = {6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17};
+			Profiles out;
+			for(int mode = 0; mode < 2; mode++) {
+				const double *profile = mode == 0 ? major : minor;
+				double mean = 0.0;
+				for(int i = 0; i < 12; i++) mean += profile[i] / 12.0;
+				double norm = 0.0;
+				for(int i = 0; i < 12; i++) norm += (profile[i] - mean) * (profile[i] - mean);
+				for(int tonic = 0; tonic < 12; tonic++) {
+					int key = mode * 12 + tonic;
+					out.norm[key] = norm;
+					for(int pc = 0; pc < 12; pc++) out.byPitchClass[pc][key] = profile[(pc - tonic + 12) % 12] - mean;
+				}
+			}
+			return out;
+		}();
+		return p;
+	}
+
+	std::array<double, 12> bins;        // true value = bins * scale
+	std::array<double, NUM_KEYS> dots;  // sum over pc of bins * centred profile
+	double sum, sumSq;                  // of bins
+	double scale;
+
+	void rebase() {
+		sum = 0.0;
+		sumSq = 0.0;
+		dots.fill(0.0);
+		for(int pc = 0; pc < 12; pc++) {
+			double b = bins[pc] * scale;
+			bins[pc] = b < 1e-300 ? 0.0 : b;
+		}
+		scale = 1.0;
+		for(int pc = 0; pc < 12; pc++) {
+			double b = bins[pc];
+			sum += b;
+			sumSq += b * b;
+			for(int k = 0; k < NUM_KEYS; k++) dots[k] += b * profiles().byPitchClass[pc][k];
+		}
+	}
+};
+
+#endif /* pitchClassHistogram_h */
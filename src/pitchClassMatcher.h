@@ -0,0 +1,146 @@
+#ifndef pitchClassMatcher_h
+#define pitchClassMatcher_h
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+// Pitch-class sets as 12-bit masks: bit i set = pitch class i present
+namespace pitchClassMask {
+	constexpr uint16_t FULL = 0x0fff;
+	constexpr int NUM_MASKS = 1 << 12;
+
+	// Every pitch class moved up by `semitones`
+	inline uint16_t transpose(uint16_t mask, int semitones) {
+		int r = ((semitones % 12) + 12) % 12;
+		return uint16_t(((mask << r) | (mask >> (12 - r))) & FULL);
+	}
+
+	inline int count(uint16_t mask) {
+		int n = 0;
+		for(; mask; mask &= mask - 1) n++;
+		return n;
+	}
+
+	inline int pitchClassOf(float pitch) {
+		int pc = ((int)round(pitch)) % 12;
+		return pc < 0 ? pc + 12 : pc;
+	}
+
+	inline uint16_t fromPitches(const std::vector<float> &pitches) {
+		uint16_t mask = 0;
+		for(float p : pitches) mask |= uint16_t(1u << pitchClassOf(p));
+		return mask;
+	}
+
+	inline uint16_t fromIntervals(const std::set<int> &intervals) {
+		uint16_t mask = 0;
+		for(int i : intervals) mask |= uint16_t(1u << (((i % 12) + 12) % 12));
+		return mask;
+	}
+
+	// Ascending pitch classes
+	inline std::vector<int> toVector(uint16_t mask) {
+		std::vector<int> pcs;
+		for(int pc = 0; pc < 12; pc++) if(mask & (1u << pc)) pcs.push_back(pc);
+		return pcs;
+	}
+}
+
+// A chord or scale library compiled to masks, with each pattern's 12
+// transpositions precomputed. match() returns what harmonyDetector has always
+// reported for an input set:
+//   1. the first pattern (smallest first, then file order) that equals the
+//      input at some root, lowest root first;
+//   2. otherwise the largest pattern contained in the input at some root
+//      (first one on ties, lowest root).
+// With the lookup table built, all 4096 inputs are resolved up front and
+// match() is a single array read; without it, a scan of AND / compare ops.
+class pitchClassMatcher {
+public:
+	struct Match {
+		int pattern = -1;  // index into the compiled library
+		int root = -1;     // pitch class of the root
+		bool found() const { return pattern >= 0; }
+	};
+
+	void clear() {
+		patterns.clear();
+		table.clear();
+	}
+
+	void add(const std::string &name, uint16_t intervalMask) {
+		if(intervalMask == 0) return;
+		Pattern p;
+		p.name = name;
+		p.size = pitchClassMask::count(intervalMask);
+		for(int root = 0; root < 12; root++) p.atRoot[root] = pitchClassMask::transpose(intervalMask, root);
+		patterns.push_back(std::move(p));
+	}
+
+	// Call once after the last add()
+	void compile(bool buildTable) {
+		std::stable_sort(patterns.begin(), patterns.end(), [](const Pattern &a, const Pattern &b) {
+			return a.size < b.size;
+		});
+		table.clear();
+		if(!buildTable) return;
+		table.resize(pitchClassMask::NUM_MASKS);
+		for(int m = 1; m < pitchClassMask::NUM_MASKS; m++) table[m] = search(uint16_t(m));
+	}
+
+	Match match(uint16_t input) const {
+		input &= pitchClassMask::FULL;
+		if(!table.empty()) return table[input];
+		return search(input);
+	}
+
+	size_t size() const { return patterns.size(); }
+	const std::string& name(int pattern) const { return patterns[pattern].name; }
+	uint16_t intervals(int pattern) const { return patterns[pattern].atRoot[0]; }
+
+private:
+	struct Pattern {
+		std::string name;
+		int size = 0;
+		std::array<uint16_t, 12> atRoot;  // the pattern transposed to each root
+	};
+
+	std::vector<Pattern> patterns;
+	std::vector<Match> table;  // NUM_MASKS entries when built
+
+	Match search(uint16_t input) const {
+		Match result;
+		if(input == 0) return result;
+		int inputSize = pitchClassMask::count(input);
+
+		for(size_t i = 0; i < patterns.size(); i++) {
+			const Pattern &p = patterns[i];
+			if(p.size != inputSize) continue;
+			for(int root = 0; root < 12; root++) {
+				if(p.atRoot[root] == input) return {int(i), root};
+			}
+		}
+
+		int bestSize = 0;
+		for(size_t i = 0; i < patterns.size(); i++) {
+			const Pattern &p = patterns[i];
+			if(p.size > inputSize) break;  // sorted by size
+			if(p.size <= bestSize) continue;
+			for(int root = 0; root < 12; root++) {
+				if((p.atRoot[root] & ~input) == 0) {
+					result = {int(i), root};
+					bestSize = p.size;
+					break;
+				}
+			}
+		}
+		return result;
+	}
+};
+
+#endif /* pitchClassMatcher_h */
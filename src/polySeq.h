@@ -4,6 +4,7 @@
 #include "ofxOceanodeNodeModel.h"
 #include "ofxOceanodeShared.h"
 #include "imgui_internal.h"
+#include "sequencerContext.h"
 #include <fstream>
 #include <vector>
 #include <algorithm>
@@ -223,6 +224,7 @@ private:
 	ofParameter<bool> probabilistic;
 	vector<int> lastSteps;
 	vector<float> lastPhasors;
+	sequencerRng rng{this};
 
 	
 	void updateNumSliders() {
@@ -279,7 +281,7 @@ private:
 					if(i < lastSteps.size() && i < lastPhasors.size()) {
 						if (step != lastSteps[i] || phasor < lastPhasors[i]) {
 							float probability = vectorValues[i][step];
-							float randomValue = ofRandom(1.0f);
+							float randomValue = rng.uniform(1.0f);
 							currentOutputs[i] = (randomValue < probability) ? 1.0f : 0.0f;
 							lastSteps[i] = step;
 						}
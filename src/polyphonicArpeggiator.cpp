@@ -1,14 +1,12 @@
 #include "polyphonicArpeggiator.h"
 #include "imgui.h"
 #include "ofxOceanodeShared.h"
-#include <chrono>
 
 // ═══════════════════════════════════════════════════════════
 // CONSTRUCTOR / DESTRUCTOR
 // ═══════════════════════════════════════════════════════════
 
 polyphonicArpeggiator::polyphonicArpeggiator() : ofxOceanodeNodeModel("Polyphonic Arpeggiator") {
-	rng = std::mt19937(std::chrono::steady_clock::now().time_since_epoch().count());
 	dist01 = std::uniform_real_distribution<float>(0.0f, 1.0f);
 
 	currentStep = 0;
@@ -31,6 +29,7 @@ polyphonicArpeggiator::polyphonicArpeggiator() : ofxOceanodeNodeModel("Polyphoni
 	stepVelocities.reserve(MAX_SEQUENCE_SIZE);
 	stepGates.reserve(MAX_SEQUENCE_SIZE);
 	deviationValues.reserve(MAX_SEQUENCE_SIZE);
+	slotEdges.resize(MAX_SEQUENCE_SIZE);
 
 	snapshotSlots.resize(16);
 	activeSnapshotSlot = -1;
@@ -62,6 +61,8 @@ void polyphonicArpeggiator::setup() {
 	// --- MODES ----
 	addParameter(dynamicMode.set("Dynamic", false));
 	addParameter(accentOnsetMode.set("AccOnset", true));  // true = onset-based (counter only when step fires), false = step-based (counter every trigger)
+	addParameter(eventMode.set("Event Out", false));  // also emit timestamped gate-on / gate-off events (Ev outputs)
+	addParameter(lookaheadMs.set("Lookahead ms", 50.0f, 0.0f, 1000.0f));
 
 	// ── TRIGGER & CONTROL ──
 	addSeparator("Trigger", ofColor(200));
@@ -138,6 +139,16 @@ void polyphonicArpeggiator::setup() {
 		vector<int>(16, 0), vector<int>(1, 0), vector<int>(1, 1)));
 	addOutputParameter(eucDurOut.set("EucDurOut",
 		vector<int>(16, 0), vector<int>(1, 0), vector<int>(1, 1)));
+	addOutputParameter(eventDelayOut.set("Ev Delay ms", {0}, {-FLT_MAX}, {FLT_MAX}));
+	addOutputParameter(eventOnOut.set("Ev On", {0}, {0}, {1}));
+	addOutputParameter(eventSlotOut.set("Ev Slot", {0}, {0}, {MAX_SEQUENCE_SIZE - 1}));
+	addOutputParameter(eventPitchOut.set("Ev Pitch", {0}, {0}, {127}));
+	addOutputParameter(eventVelOut.set("Ev Vel", {0}, {0}, {1}));
+	eventDelayOut.setSerializable(false);
+	eventOnOut.setSerializable(false);
+	eventSlotOut.setSerializable(false);
+	eventPitchOut.setSerializable(false);
+	eventVelOut.setSerializable(false);
 
 	// ── DISPLAY ──
 	addSeparator("Display", ofColor(200));
@@ -159,89 +170,34 @@ void polyphonicArpeggiator::setup() {
 	listeners.push(reset.newListener([this](void){ onReset(); }));
 	listeners.push(resetNext.newListener([this](void){ onResetNext(); }));
 
-	// Euclidean patterns
-	listeners.push(eucLen.newListener([this](int&){
-		generateEuclideanPattern(euclideanPattern, eucLen, eucHits, eucOff);
-		rebuildEuclideanOutputs();
-	}));
-	listeners.push(eucHits.newListener([this](int&){
-		generateEuclideanPattern(euclideanPattern, eucLen, eucHits, eucOff);
-		rebuildEuclideanOutputs();
-	}));
-	listeners.push(eucOff.newListener([this](int&){
-		generateEuclideanPattern(euclideanPattern, eucLen, eucHits, eucOff);
-		rebuildEuclideanOutputs();
-	}));
+	// Parameter changes only mark what they invalidate; requestRebuild() runs
+	// it right away, or once at endBatch() while a morph / recall is writing
+	listeners.push(eucLen.newListener([this](int&){ requestRebuild(REBUILD_EUC_GATE); }));
+	listeners.push(eucHits.newListener([this](int&){ requestRebuild(REBUILD_EUC_GATE); }));
+	listeners.push(eucOff.newListener([this](int&){ requestRebuild(REBUILD_EUC_GATE); }));
 
-	listeners.push(eucAccLen.newListener([this](int&){
-		generateEuclideanPattern(euclideanAccents, eucAccLen, eucAccHits, eucAccOff);
-		rebuildEuclideanOutputs();
-	}));
-	listeners.push(eucAccHits.newListener([this](int&){
-		generateEuclideanPattern(euclideanAccents, eucAccLen, eucAccHits, eucAccOff);
-		rebuildEuclideanOutputs();
-	}));
-	listeners.push(eucAccOff.newListener([this](int&){
-		generateEuclideanPattern(euclideanAccents, eucAccLen, eucAccHits, eucAccOff);
-		rebuildEuclideanOutputs();
-	}));
+	listeners.push(eucAccLen.newListener([this](int&){ requestRebuild(REBUILD_EUC_ACCENT); }));
+	listeners.push(eucAccHits.newListener([this](int&){ requestRebuild(REBUILD_EUC_ACCENT); }));
+	listeners.push(eucAccOff.newListener([this](int&){ requestRebuild(REBUILD_EUC_ACCENT); }));
 
-	listeners.push(eucDurLen.newListener([this](int&){
-		generateEuclideanPattern(euclideanDurations, eucDurLen, eucDurHits, eucDurOff);
-		rebuildEuclideanOutputs();
-	}));
-	listeners.push(eucDurHits.newListener([this](int&){
-		generateEuclideanPattern(euclideanDurations, eucDurLen, eucDurHits, eucDurOff);
-		rebuildEuclideanOutputs();
-	}));
-	listeners.push(eucDurOff.newListener([this](int&){
-		generateEuclideanPattern(euclideanDurations, eucDurLen, eucDurHits, eucDurOff);
-		rebuildEuclideanOutputs();
-	}));
+	listeners.push(eucDurLen.newListener([this](int&){ requestRebuild(REBUILD_EUC_DURATION); }));
+	listeners.push(eucDurHits.newListener([this](int&){ requestRebuild(REBUILD_EUC_DURATION); }));
+	listeners.push(eucDurOff.newListener([this](int&){ requestRebuild(REBUILD_EUC_DURATION); }));
 
 	// Pitch rebuild triggers
-	listeners.push(scale.newListener([this](vector<float>&){
-		rebuildExpandedScale();
-		rebuildPitchSequence();
-	}));
-	listeners.push(idxPattern.newListener([this](vector<int>&){
-		rebuildPitchSequence();
-	}));
-	listeners.push(degStart.newListener([this](int&){
-		rebuildPitchSequence();
-	}));
-	listeners.push(stepInterval.newListener([this](int&){
-		rebuildPitchSequence();
-	}));
-	listeners.push(transpose.newListener([this](int&){
-		rebuildPitchSequence();
-	}));
+	listeners.push(scale.newListener([this](vector<float>&){ requestRebuild(REBUILD_SCALE); }));
+	listeners.push(idxPattern.newListener([this](vector<int>&){ requestRebuild(REBUILD_PITCH); }));
+	listeners.push(degStart.newListener([this](int&){ requestRebuild(REBUILD_PITCH); }));
+	listeners.push(stepInterval.newListener([this](int&){ requestRebuild(REBUILD_PITCH); }));
+	listeners.push(transpose.newListener([this](int&){ requestRebuild(REBUILD_PITCH); }));
 	
 	// Deviation parameter listeners - regenerate deviations and rebuild pitch sequence
-	listeners.push(octaveDev.newListener([this](float&){
-		rebuildDeviations();
-		rebuildPitchSequence();
-	}));
-	listeners.push(octaveDevRng.newListener([this](int&){
-		rebuildDeviations();
-		rebuildPitchSequence();
-	}));
-	listeners.push(idxDev.newListener([this](float&){
-		rebuildDeviations();
-		rebuildPitchSequence();
-	}));
-	listeners.push(idxDevRng.newListener([this](int&){
-		rebuildDeviations();
-		rebuildPitchSequence();
-	}));
-	listeners.push(pitchDev.newListener([this](float&){
-		rebuildDeviations();
-		rebuildPitchSequence();
-	}));
-	listeners.push(pitchDevRng.newListener([this](int&){
-		rebuildDeviations();
-		rebuildPitchSequence();
-	}));
+	listeners.push(octaveDev.newListener([this](float&){ requestRebuild(REBUILD_DEVIATIONS); }));
+	listeners.push(octaveDevRng.newListener([this](int&){ requestRebuild(REBUILD_DEVIATIONS); }));
+	listeners.push(idxDev.newListener([this](float&){ requestRebuild(REBUILD_DEVIATIONS); }));
+	listeners.push(idxDevRng.newListener([this](int&){ requestRebuild(REBUILD_DEVIATIONS); }));
+	listeners.push(pitchDev.newListener([this](float&){ requestRebuild(REBUILD_DEVIATIONS); }));
+	listeners.push(pitchDevRng.newListener([this](int&){ requestRebuild(REBUILD_DEVIATIONS); }));
 	listeners.push(patternMode.newListener([this](int&){
 		// Pattern mode only affects gate traversal, not pitch vector
 		// No need to rebuild pitch sequence
@@ -249,25 +205,15 @@ void polyphonicArpeggiator::setup() {
 	listeners.push(dynamicMode.newListener([this](bool& val){
 		if(!val) {
 			// Returning to static mode: restore the precomputed pitch sequence
-			rebuildPitchSequence();
+			requestRebuild(REBUILD_PITCH);
 		}
 	}));
 
 	// seqSize change
-	listeners.push(seqSize.newListener([this](int& size){
-		currentPitches.resize(size, 60.0f);
-		currentGates.resize(size, 0);
-		currentVelocities.resize(size, 0.0f);
-		currentDurations.resize(size, 0.0f);
-		noteDurationsMs.resize(size, 100);
-		noteStartTimes.resize(size, 0);
-		stepVelocities.resize(size, 0.0f);
-		stepGates.resize(size, false);
-		deviationValues.resize(size, 0.0f);
-		rebuildDeviations();
-		rebuildPitchSequence();
-		rebuildEuclideanOutputs();
-		updateOutputs();
+	listeners.push(seqSize.newListener([this](int&){ requestRebuild(REBUILD_SIZE); }));
+
+	listeners.push(eventMode.newListener([this](bool& val){
+		if(!val) clearEventQueue();
 	}));
 
 	// Initialize euclidean patterns
@@ -302,35 +248,155 @@ void polyphonicArpeggiator::setup() {
 // ═══════════════════════════════════════════════════════════
 
 void polyphonicArpeggiator::update(ofEventArgs &e) {
-	auto currentTime = std::chrono::steady_clock::now().time_since_epoch();
-	auto currentMs = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime).count();
-	bool needsUpdate = false;
-
-	// Check all possible active slots (up to 16)
-	for(int i = 0; i < MAX_POLYPHONY; i++) {
-		if(i>=currentGates.size()) continue;
-		// Strum start: gate was scheduled to fire at noteStartTimes[i].
-		// Reset noteStartTimes[i] to actual fire time so the duration-expiry
-		// check below measures from when the note truly started, not when it
-		// was scheduled. Without this, a delayed voice can turn on and
-		// immediately expire in the same update() frame.
-		if(currentGates[i] == 0 && noteStartTimes[i] > 0 && currentMs >= (int64_t)noteStartTimes[i]) {
-			currentGates[i] = 1;
-			noteStartTimes[i] = currentMs;
-			needsUpdate = true;
+	if(isMorphing) updateMorph();
+
+	if(eventMode) {
+		uint64_t nowUs = sequencerContext::get().nowMicros();
+		drainEvents(nowUs, nowUs + lookaheadUs());
+	}
+
+	// Strum starts and gate-offs run on gateTimers; publish what they changed
+	if(gatesChanged) {
+		gatesChanged = false;
+		updateOutputs();
+	}
+}
+
+// ═══════════════════════════════════════════════════════════
+// GATE TIMERS (one per slot, on the timerService clock)
+// ═══════════════════════════════════════════════════════════
+
+void polyphonicArpeggiator::scheduleGateOff(int slot) {
+	uint64_t offMs = noteStartTimes[slot] + (uint64_t)std::max(0, noteDurationsMs[slot]);
+	gateTimers.atTime(slot, offMs * 1000, [this, slot](uint64_t, uint64_t) {
+		currentGates[slot] = 0;
+		noteStartTimes[slot] = 0;
+		gatesChanged = true;
+	});
+}
+
+void polyphonicArpeggiator::scheduleStrum(int slot) {
+	gateTimers.atTime(slot, noteStartTimes[slot] * 1000, [this, slot](uint64_t, uint64_t nowUs) {
+		// Reset noteStartTimes to the actual fire time so the duration is
+		// measured from when the note truly started, not when it was
+		// scheduled. Otherwise a late voice could turn on and expire at once.
+		currentGates[slot] = 1;
+		noteStartTimes[slot] = nowUs / 1000;
+		gatesChanged = true;
+		scheduleGateOff(slot);
+	});
+}
+
+// ═══════════════════════════════════════════════════════════
+// EVENT QUEUE (Event Out — exact edge timestamps)
+//   processStep() queues each note's on and off at the time the
+//   strum offset and duration put them; drainEvents() hands out
+//   everything due within the lookahead window in time order.
+// ═══════════════════════════════════════════════════════════
+
+namespace {
+	// std heap functions build a max-heap; invert for earliest-first,
+	// FIFO among equal times so a slot's off precedes its next on
+	struct EventLater {
+		template<typename Q>
+		bool operator()(const Q& a, const Q& b) const {
+			return a.ev.timeUs != b.ev.timeUs ? a.ev.timeUs > b.ev.timeUs : a.seq > b.seq;
 		}
-		// Duration expire
-		if(currentGates[i] == 1 && noteStartTimes[i] > 0) {
-			if(currentMs >= (int64_t)(noteStartTimes[i] + noteDurationsMs[i])) {
-				currentGates[i] = 0;
-				noteStartTimes[i] = 0;
-				needsUpdate = true;
-			}
+	};
+}
+
+void polyphonicArpeggiator::pushEvent(const ArpeggiatorEvent& ev) {
+	eventQueue.push_back({ev, nextEventSeq++, slotEdges[ev.slot].gen});
+	std::push_heap(eventQueue.begin(), eventQueue.end(), EventLater());
+}
+
+void polyphonicArpeggiator::queueNote(int slot, uint64_t onUs) {
+	ArpeggiatorEvent ev;
+	ev.timeUs = std::max(onUs, slotEdges[slot].freeUs);
+	ev.on = true;
+	ev.slot = slot;
+	ev.pitch = currentPitches[slot];
+	ev.velocity = currentVelocities[slot];
+	pushEvent(ev);
+
+	ev.timeUs += (uint64_t)std::max(0, noteDurationsMs[slot]) * 1000;
+	ev.on = false;
+	ev.velocity = 0.0f;
+	pushEvent(ev);
+}
+
+// Edges go out up to a lookahead early, so the slot's last published on or off
+// may still lie ahead: the cut and the slot's next note can't precede it
+void polyphonicArpeggiator::cutSlotEvents(int slot, uint64_t nowUs) {
+	SlotEdges& se = slotEdges[slot];
+	se.gen++;
+	se.freeUs = std::max(nowUs, se.lastUs);
+	if(!se.sounding) return;
+
+	ArpeggiatorEvent off;
+	off.timeUs = se.freeUs;
+	off.slot = slot;
+	off.pitch = se.pitch;
+	pushEvent(off);
+}
+
+uint64_t polyphonicArpeggiator::lookaheadUs() const {
+	return (uint64_t)(std::max(0.0f, lookaheadMs.get()) * 1000.0f);
+}
+
+void polyphonicArpeggiator::drainEvents(uint64_t nowUs, uint64_t horizonUs) {
+	eventBatch.clear();
+	while(!eventQueue.empty() && eventQueue.front().ev.timeUs <= horizonUs) {
+		QueuedEvent q = eventQueue.front();
+		std::pop_heap(eventQueue.begin(), eventQueue.end(), EventLater());
+		eventQueue.pop_back();
+
+		SlotEdges& se = slotEdges[q.ev.slot];
+		if(q.gen != se.gen) continue;  // slot re-triggered since
+		if(q.ev.on) {
+			se.sounding = true;
+			se.pitch = q.ev.pitch;
+		} else {
+			if(!se.sounding) continue;
+			se.sounding = false;
 		}
+		se.lastUs = q.ev.timeUs;
+		eventBatch.push_back(q.ev);
 	}
-	
-	if(isMorphing) updateMorph();
-	if(needsUpdate) updateOutputs();
+
+	if(eventBatch.empty() && !eventsPublished) return;
+	vector<float> delays, pitches, vels;
+	vector<int> ons, slots;
+	delays.reserve(eventBatch.size());
+	ons.reserve(eventBatch.size());
+	slots.reserve(eventBatch.size());
+	pitches.reserve(eventBatch.size());
+	vels.reserve(eventBatch.size());
+	for(const auto& e : eventBatch) {
+		delays.push_back(float((int64_t)e.timeUs - (int64_t)nowUs) / 1000.0f);
+		ons.push_back(e.on ? 1 : 0);
+		slots.push_back(e.slot);
+		pitches.push_back(e.pitch);
+		vels.push_back(e.velocity);
+	}
+	eventDelayOut = delays;
+	eventOnOut = ons;
+	eventSlotOut = slots;
+	eventPitchOut = pitches;
+	eventVelOut = vels;
+	if(!eventBatch.empty()) ofNotifyEvent(scheduledEvents, eventBatch, this);
+	eventsPublished = !eventBatch.empty();
+}
+
+// Leaving event mode: close every sounding note and forget the rest. A note's
+// off can't precede its already-published on, which may lie up to a lookahead
+// ahead, and update() stops draining once event mode is off, so every off goes
+// out in this batch with whatever delay it needs
+void polyphonicArpeggiator::clearEventQueue() {
+	uint64_t nowUs = sequencerContext::get().nowMicros();
+	eventQueue.clear();
+	for(int i = 0; i < MAX_SEQUENCE_SIZE; i++) cutSlotEvents(i, nowUs);
+	drainEvents(nowUs, UINT64_MAX);
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -400,8 +466,8 @@ void polyphonicArpeggiator::processStep() {
 	// AccOnset=false → absoluteStepCounter (counts every trigger, independent of seqSize)
 	int accentIdx = accentOnsetMode.get() ? onsetCounter : absoluteStepCounter;
 
-	auto currentTime = std::chrono::steady_clock::now().time_since_epoch();
-	auto currentMs = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime).count();
+	uint64_t nowUs = sequencerContext::get().nowMicros();
+	auto currentMs = (int64_t)(nowUs / 1000);
 
 	int poly = std::min((int)polyphony.get(), MAX_POLYPHONY);
 	int polyInt = polyInterval.get();
@@ -414,6 +480,8 @@ void polyphonicArpeggiator::processStep() {
 			currentGates[i] = 0;
 			stepGates[i] = false;
 			noteStartTimes[i] = 0;  // Clear any pending strums from previous trigger
+			gateTimers.cancel(i);
+			if(eventMode) cutSlotEvents(i, nowUs);
 		}
 
 		// Recompute ALL seqSize pitch slots so the whole pitch vector moves each trigger
@@ -441,9 +509,12 @@ void polyphonicArpeggiator::processStep() {
 				currentGates[outputSlot] = 1;
 				stepGates[outputSlot] = true;
 				noteStartTimes[outputSlot] = currentMs;
+				scheduleGateOff(outputSlot);
 			} else {
 				noteStartTimes[outputSlot] = currentMs + (uint64_t)strumOffset;
+				scheduleStrum(outputSlot);
 			}
+			if(eventMode) queueNote(outputSlot, nowUs + (uint64_t)(std::max(0.0f, strumOffset) * 1000.0f));
 		}
 	} else {
 		// STANDARD MODE: Sequence-Slot (Original behavior)
@@ -473,17 +544,21 @@ void polyphonicArpeggiator::processStep() {
 			if(!slotIsSustaining) {
 				noteDurationsMs[outputIndex] = stepDuration;
 				float strumOffset = computeStrumOffset(voice, poly);
+				if(eventMode) {
+					cutSlotEvents(outputIndex, nowUs);
+					queueNote(outputIndex, nowUs + (uint64_t)(std::max(0.0f, strumOffset) * 1000.0f));
+				}
 				if(strumOffset <= 0.5f) {
 					currentGates[outputIndex] = 1;
 					stepGates[outputIndex] = true;
 					noteStartTimes[outputIndex] = currentMs;
+					scheduleGateOff(outputIndex);
 				} else {
-					// Explicitly clear the gate so the update() strum-start condition
-					// (currentGates[i] == 0) can fire. Without this, a gate left as 1
-					// from an expired-but-not-yet-cleared note blocks the strum forever.
+					// Clear the gate until the strum timer turns it on
 					currentGates[outputIndex] = 0;
 					stepGates[outputIndex] = false;
 					noteStartTimes[outputIndex] = currentMs + (uint64_t)strumOffset;
+					scheduleStrum(outputIndex);
 				}
 			}
 		}
@@ -491,6 +566,9 @@ void polyphonicArpeggiator::processStep() {
 
 	highlightedStep = currentStep;
 	updateOutputs();
+
+	// Hand out what this step put inside the window without waiting a frame
+	if(eventMode) drainEvents(nowUs, nowUs + lookaheadUs());
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -662,6 +740,61 @@ void polyphonicArpeggiator::rebuildEuclideanOutputs() {
 	eucDurOut.set(eucDur);
 }
 
+// ═══════════════════════════════════════════════════════════
+// DEFERRED REBUILDS (one pass per parameter batch)
+// ═══════════════════════════════════════════════════════════
+
+void polyphonicArpeggiator::requestRebuild(uint32_t flags) {
+	pendingRebuilds |= flags;
+	if(batchDepth == 0) flushRebuilds();
+}
+
+void polyphonicArpeggiator::beginBatch() {
+	batchDepth++;
+}
+
+void polyphonicArpeggiator::endBatch() {
+	if(batchDepth > 0 && --batchDepth == 0) flushRebuilds();
+}
+
+// Runs every pending rebuild once, expanding each flag into what depends on it
+void polyphonicArpeggiator::flushRebuilds() {
+	uint32_t f = pendingRebuilds;
+	pendingRebuilds = 0;
+	if(f == 0) return;
+
+	if(f & REBUILD_SIZE) {
+		int size = seqSize.get();
+		currentPitches.resize(size, 60.0f);
+		currentGates.resize(size, 0);
+		currentVelocities.resize(size, 0.0f);
+		currentDurations.resize(size, 0.0f);
+		noteDurationsMs.resize(size, 100);
+		noteStartTimes.resize(size, 0);
+		gateTimers.cancelFrom(size);
+		stepVelocities.resize(size, 0.0f);
+		stepGates.resize(size, false);
+		deviationValues.resize(size, 0.0f);
+		f |= REBUILD_DEVIATIONS | REBUILD_EUC_OUTPUTS;
+	}
+	if(f & REBUILD_SCALE) {
+		rebuildExpandedScale();
+		f |= REBUILD_PITCH;
+	}
+	if(f & REBUILD_EUC_GATE) generateEuclideanPattern(euclideanPattern, eucLen, eucHits, eucOff);
+	if(f & REBUILD_EUC_ACCENT) generateEuclideanPattern(euclideanAccents, eucAccLen, eucAccHits, eucAccOff);
+	if(f & REBUILD_EUC_DURATION) generateEuclideanPattern(euclideanDurations, eucDurLen, eucDurHits, eucDurOff);
+	if(f & (REBUILD_EUC_GATE | REBUILD_EUC_ACCENT | REBUILD_EUC_DURATION)) f |= REBUILD_EUC_OUTPUTS;
+
+	if(f & REBUILD_DEVIATIONS) {
+		rebuildDeviations();
+		f |= REBUILD_PITCH;
+	}
+	if(f & REBUILD_PITCH) rebuildPitchSequence();
+	if(f & REBUILD_EUC_OUTPUTS) rebuildEuclideanOutputs();
+	if(f & REBUILD_SIZE) updateOutputs();
+}
+
 // ═══════════════════════════════════════════════════════════
 // PITCH DEVIATIONS (all positive-only)
 // ═══════════════════════════════════════════════════════════
@@ -1043,6 +1176,7 @@ void polyphonicArpeggiator::recallSlot(int slot) {
 		// Instant recall
 		ArpeggiatorSnapshot snap = snapshotSlots[slot];
 
+		beginBatch();
 		seqSize.set(snap.seqSize);
 
 		scale.set(snap.scale);
@@ -1088,6 +1222,7 @@ void polyphonicArpeggiator::recallSlot(int slot) {
 
 		dynamicMode.set(snap.dynamicMode);
 		accentOnsetMode.set(snap.accentOnsetMode);
+		endBatch();
 
 	} else {
 		// Morphing recall
@@ -1137,70 +1272,77 @@ void polyphonicArpeggiator::recallSlot(int slot) {
 		startSnapshot.noteChance = noteChance.get();
 
 		targetSnapshot = snapshotSlots[slot];
-		morphStartTime = ofGetElapsedTimef();
+		morphStartTime = sequencerContext::get().nowSeconds();
 		isMorphing = true;
 	}
 }
 
 void polyphonicArpeggiator::updateMorph() {
-	float now = ofGetElapsedTimef();
+	float now = sequencerContext::get().nowSeconds();
 	float progress = (now - morphStartTime) / std::max(morphTime.get(), 0.001f);
 	if(progress >= 1.0f) {
 		progress = 1.0f;
 		isMorphing = false;
 	}
 
+	// Write everything first and rebuild once: without the batch each of these
+	// sets would rerun the deviation / pitch / euclidean rebuilds it touches.
+	// Unchanged values are skipped, which is most of them on a given frame.
+	beginBatch();
+
 	// Lerp integer values
-	seqSize.set((int)ofLerp(startSnapshot.seqSize, targetSnapshot.seqSize, progress));
-	transpose.set((int)ofLerp(startSnapshot.transpose, targetSnapshot.transpose, progress));
-	degStart.set((int)ofLerp(startSnapshot.degStart, targetSnapshot.degStart, progress));
-	stepInterval.set((int)ofLerp(startSnapshot.stepInterval, targetSnapshot.stepInterval, progress));
-	polyphony.set((int)ofLerp(startSnapshot.polyphony, targetSnapshot.polyphony, progress));
-	polyInterval.set((int)ofLerp(startSnapshot.polyInterval, targetSnapshot.polyInterval, progress));
-	skipSteps.set((int)ofLerp(startSnapshot.skipSteps, targetSnapshot.skipSteps, progress));
-
-	strum.set(ofLerp(startSnapshot.strum, targetSnapshot.strum, progress));
-	strumRndm.set(ofLerp(startSnapshot.strumRndm, targetSnapshot.strumRndm, progress));
-
-	octaveDev.set(ofLerp(startSnapshot.octaveDev, targetSnapshot.octaveDev, progress));
-	octaveDevRng.set((int)ofLerp(startSnapshot.octaveDevRng, targetSnapshot.octaveDevRng, progress));
-	idxDev.set(ofLerp(startSnapshot.idxDev, targetSnapshot.idxDev, progress));
-	idxDevRng.set((int)ofLerp(startSnapshot.idxDevRng, targetSnapshot.idxDevRng, progress));
-	pitchDev.set(ofLerp(startSnapshot.pitchDev, targetSnapshot.pitchDev, progress));
-	pitchDevRng.set((int)ofLerp(startSnapshot.pitchDevRng, targetSnapshot.pitchDevRng, progress));
-
-	velBase.set(ofLerp(startSnapshot.velBase, targetSnapshot.velBase, progress));
-	velRndm.set(ofLerp(startSnapshot.velRndm, targetSnapshot.velRndm, progress));
-	eucAccStrength.set(ofLerp(startSnapshot.eucAccStrength, targetSnapshot.eucAccStrength, progress));
-
-	durBase.set((int)ofLerp(startSnapshot.durBase, targetSnapshot.durBase, progress));
-	durRndm.set((int)ofLerp(startSnapshot.durRndm, targetSnapshot.durRndm, progress));
-	durEucStrength.set((int)ofLerp(startSnapshot.durEucStrength, targetSnapshot.durEucStrength, progress));
-
-	eucLen.set((int)ofLerp(startSnapshot.eucLen, targetSnapshot.eucLen, progress));
-	eucHits.set((int)ofLerp(startSnapshot.eucHits, targetSnapshot.eucHits, progress));
-	eucOff.set((int)ofLerp(startSnapshot.eucOff, targetSnapshot.eucOff, progress));
-	eucAccLen.set((int)ofLerp(startSnapshot.eucAccLen, targetSnapshot.eucAccLen, progress));
-	eucAccHits.set((int)ofLerp(startSnapshot.eucAccHits, targetSnapshot.eucAccHits, progress));
-	eucAccOff.set((int)ofLerp(startSnapshot.eucAccOff, targetSnapshot.eucAccOff, progress));
-	eucDurLen.set((int)ofLerp(startSnapshot.eucDurLen, targetSnapshot.eucDurLen, progress));
-	eucDurHits.set((int)ofLerp(startSnapshot.eucDurHits, targetSnapshot.eucDurHits, progress));
-	eucDurOff.set((int)ofLerp(startSnapshot.eucDurOff, targetSnapshot.eucDurOff, progress));
-
-	stepChance.set(ofLerp(startSnapshot.stepChance, targetSnapshot.stepChance, progress));
-	noteChance.set(ofLerp(startSnapshot.noteChance, targetSnapshot.noteChance, progress));
+	setIfChanged(seqSize, (int)ofLerp(startSnapshot.seqSize, targetSnapshot.seqSize, progress));
+	setIfChanged(transpose, (int)ofLerp(startSnapshot.transpose, targetSnapshot.transpose, progress));
+	setIfChanged(degStart, (int)ofLerp(startSnapshot.degStart, targetSnapshot.degStart, progress));
+	setIfChanged(stepInterval, (int)ofLerp(startSnapshot.stepInterval, targetSnapshot.stepInterval, progress));
+	setIfChanged(polyphony, (int)ofLerp(startSnapshot.polyphony, targetSnapshot.polyphony, progress));
+	setIfChanged(polyInterval, (int)ofLerp(startSnapshot.polyInterval, targetSnapshot.polyInterval, progress));
+	setIfChanged(skipSteps, (int)ofLerp(startSnapshot.skipSteps, targetSnapshot.skipSteps, progress));
+
+	setIfChanged(strum, ofLerp(startSnapshot.strum, targetSnapshot.strum, progress));
+	setIfChanged(strumRndm, ofLerp(startSnapshot.strumRndm, targetSnapshot.strumRndm, progress));
+
+	setIfChanged(octaveDev, ofLerp(startSnapshot.octaveDev, targetSnapshot.octaveDev, progress));
+	setIfChanged(octaveDevRng, (int)ofLerp(startSnapshot.octaveDevRng, targetSnapshot.octaveDevRng, progress));
+	setIfChanged(idxDev, ofLerp(startSnapshot.idxDev, targetSnapshot.idxDev, progress));
+	setIfChanged(idxDevRng, (int)ofLerp(startSnapshot.idxDevRng, targetSnapshot.idxDevRng, progress));
+	setIfChanged(pitchDev, ofLerp(startSnapshot.pitchDev, targetSnapshot.pitchDev, progress));
+	setIfChanged(pitchDevRng, (int)ofLerp(startSnapshot.pitchDevRng, targetSnapshot.pitchDevRng, progress));
+
+	setIfChanged(velBase, ofLerp(startSnapshot.velBase, targetSnapshot.velBase, progress));
+	setIfChanged(velRndm, ofLerp(startSnapshot.velRndm, targetSnapshot.velRndm, progress));
+	setIfChanged(eucAccStrength, ofLerp(startSnapshot.eucAccStrength, targetSnapshot.eucAccStrength, progress));
+
+	setIfChanged(durBase, (int)ofLerp(startSnapshot.durBase, targetSnapshot.durBase, progress));
+	setIfChanged(durRndm, (int)ofLerp(startSnapshot.durRndm, targetSnapshot.durRndm, progress));
+	setIfChanged(durEucStrength, (int)ofLerp(startSnapshot.durEucStrength, targetSnapshot.durEucStrength, progress));
+
+	setIfChanged(eucLen, (int)ofLerp(startSnapshot.eucLen, targetSnapshot.eucLen, progress));
+	setIfChanged(eucHits, (int)ofLerp(startSnapshot.eucHits, targetSnapshot.eucHits, progress));
+	setIfChanged(eucOff, (int)ofLerp(startSnapshot.eucOff, targetSnapshot.eucOff, progress));
+	setIfChanged(eucAccLen, (int)ofLerp(startSnapshot.eucAccLen, targetSnapshot.eucAccLen, progress));
+	setIfChanged(eucAccHits, (int)ofLerp(startSnapshot.eucAccHits, targetSnapshot.eucAccHits, progress));
+	setIfChanged(eucAccOff, (int)ofLerp(startSnapshot.eucAccOff, targetSnapshot.eucAccOff, progress));
+	setIfChanged(eucDurLen, (int)ofLerp(startSnapshot.eucDurLen, targetSnapshot.eucDurLen, progress));
+	setIfChanged(eucDurHits, (int)ofLerp(startSnapshot.eucDurHits, targetSnapshot.eucDurHits, progress));
+	setIfChanged(eucDurOff, (int)ofLerp(startSnapshot.eucDurOff, targetSnapshot.eucDurOff, progress));
+
+	setIfChanged(stepChance, ofLerp(startSnapshot.stepChance, targetSnapshot.stepChance, progress));
+	setIfChanged(noteChance, ofLerp(startSnapshot.noteChance, targetSnapshot.noteChance, progress));
 
 	// At the end, set discrete values
 	if(progress >= 1.0f) {
 		progress = 1.0f;
 		isMorphing = false;
-		dynamicMode.set(targetSnapshot.dynamicMode);
-		accentOnsetMode.set(targetSnapshot.accentOnsetMode);
-		scale.set(targetSnapshot.scale);
-		patternMode.set(targetSnapshot.patternMode);
-		idxPattern.set(targetSnapshot.idxPattern);
-		strumDir.set(targetSnapshot.strumDir);
+		setIfChanged(dynamicMode, targetSnapshot.dynamicMode);
+		setIfChanged(accentOnsetMode, targetSnapshot.accentOnsetMode);
+		setIfChanged(scale, targetSnapshot.scale);
+		setIfChanged(patternMode, targetSnapshot.patternMode);
+		setIfChanged(idxPattern, targetSnapshot.idxPattern);
+		setIfChanged(strumDir, targetSnapshot.strumDir);
 	}
+
+	endBatch();
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -1230,6 +1372,7 @@ void polyphonicArpeggiator::presetRecallAfterSettingParameters(ofJson &json) {
 	currentDurations.resize(sz, 0.0f);
 	noteDurationsMs.resize(sz, 100);
 	noteStartTimes.resize(sz, 0);
+	gateTimers.cancelFrom(sz);
 	stepVelocities.resize(sz, 0.0f);
 	stepGates.resize(sz, false);
 	deviationValues.resize(sz, 0.0f);
@@ -2,6 +2,8 @@
 #define polyphonicArpeggiator_h
 
 #include "ofxOceanodeNodeModel.h"
+#include "timerService.h"
+#include "sequencerContext.h"
 #include <random>
 #include <algorithm>
 
@@ -64,6 +66,16 @@ struct ArpeggiatorSnapshot {
     bool hasData = false;
 };
 
+// A note edge produced in event-queue mode, stamped with the exact time it is
+// due rather than the frame that delivers it
+struct ArpeggiatorEvent {
+    uint64_t timeUs = 0;    // sequencerContext::nowMicros() the edge is due at
+    bool on = false;        // gate-on / gate-off
+    int slot = 0;           // output slot (index into the vector outputs)
+    float pitch = 0.0f;
+    float velocity = 0.0f;  // 0 for gate-offs
+};
+
 class polyphonicArpeggiator : public ofxOceanodeNodeModel {
 public:
     polyphonicArpeggiator();
@@ -74,6 +86,13 @@ public:
     void presetSave(ofJson &json) override;
     void presetRecallAfterSettingParameters(ofJson &json) override;
 
+    // Event mode: edges due before now + "Lookahead ms", sorted by timeUs.
+    // Delivered as soon as they enter the window, so timestamped senders
+    // (OSC bundles, MIDI with delta times) can play strums and gate-offs on
+    // their exact time instead of the frame boundary.
+    const vector<ArpeggiatorEvent>& getScheduledEvents() const { return eventBatch; }
+    ofEvent<vector<ArpeggiatorEvent>> scheduledEvents;
+
 private:	
     // --- Core Trigger Inputs ---
     ofParameter<void> trigger;
@@ -131,6 +150,8 @@ private:
 	//--- Dynamic Mode ---
 	ofParameter<bool> dynamicMode;
 	ofParameter<bool> accentOnsetMode;
+	ofParameter<bool> eventMode;
+	ofParameter<float> lookaheadMs;
 
     // --- Output Parameters ---
     ofParameter<vector<float>> pitchOut;
@@ -141,6 +162,11 @@ private:
     ofParameter<vector<int>> eucGateOut;    // euclidean gate pattern mapped to seqSize
     ofParameter<vector<int>> eucAccOut;     // euclidean accent pattern mapped to seqSize
     ofParameter<vector<int>> eucDurOut;     // euclidean duration pattern mapped to seqSize
+    ofParameter<vector<float>> eventDelayOut;  // ms from now until each event of the batch
+    ofParameter<vector<int>> eventOnOut;
+    ofParameter<vector<int>> eventSlotOut;
+    ofParameter<vector<float>> eventPitchOut;
+    ofParameter<vector<float>> eventVelOut;
 
     // --- GUI Parameters ---
     ofParameter<float> guiWidth;
@@ -170,12 +196,34 @@ private:
     vector<float> currentDurations;
     vector<int> noteDurationsMs;          // per-slot computed duration in ms
     vector<uint64_t> noteStartTimes;      // per-slot gate-on timestamp (ms)
+    nodeTimers gateTimers;                // per-slot pending strum start or gate-off
+    bool gatesChanged = false;            // a gate timer fired since the last update()
+
+    // Event queue (event mode): min-heap on (timeUs, seq). Re-triggering a
+    // slot bumps its generation, which drops that slot's queued edges.
+    struct QueuedEvent {
+        ArpeggiatorEvent ev;
+        uint64_t seq;
+        uint32_t gen;
+    };
+    struct SlotEdges {
+        uint32_t gen = 0;
+        bool sounding = false;            // on published, off not yet
+        float pitch = 0.0f;               // of the sounding note
+        uint64_t lastUs = 0;              // latest edge published
+        uint64_t freeUs = 0;              // next on may not precede the last cut
+    };
+    vector<QueuedEvent> eventQueue;
+    vector<ArpeggiatorEvent> eventBatch;
+    vector<SlotEdges> slotEdges;          // MAX_SEQUENCE_SIZE
+    uint64_t nextEventSeq = 0;
+    bool eventsPublished = false;
 
     // Pre-calculated deviation values (regenerated only when deviation params change)
     vector<float> deviationValues;        // stores the additive pitch deviation per slot
 
     // --- Random Number Generation ---
-    std::mt19937 rng;
+    sequencerRng rng{this};
     std::uniform_real_distribution<float> dist01;
 
     // --- Helper Functions ---
@@ -195,6 +243,40 @@ private:
     int computeStepDuration(int stepIndex);
     float computeStrumOffset(int voiceIndex, int totalVoices);
     void updateOutputs();
+    void scheduleGateOff(int slot);       // gate-off at noteStartTimes + noteDurationsMs
+    void scheduleStrum(int slot);         // gate-on at noteStartTimes, then scheduleGateOff
+    void queueNote(int slot, uint64_t onUs);   // gate-on / gate-off pair for the slot's current note
+    void cutSlotEvents(int slot, uint64_t nowUs);  // drop queued edges, close a sounding note
+    void pushEvent(const ArpeggiatorEvent& ev);
+    void drainEvents(uint64_t nowUs, uint64_t horizonUs);  // publish edges due by horizonUs
+    uint64_t lookaheadUs() const;
+    void clearEventQueue();
+
+    // --- Deferred Rebuilds ---
+    // What a parameter change invalidates; flushRebuilds() adds the dependents
+    enum RebuildFlags : uint32_t {
+        REBUILD_SIZE         = 1 << 0,   // resize state vectors, then deviations + euclidean outputs
+        REBUILD_SCALE        = 1 << 1,   // expanded scale, then pitch
+        REBUILD_DEVIATIONS   = 1 << 2,   // then pitch
+        REBUILD_PITCH        = 1 << 3,
+        REBUILD_EUC_GATE     = 1 << 4,   // regenerate pattern, then euclidean outputs
+        REBUILD_EUC_ACCENT   = 1 << 5,
+        REBUILD_EUC_DURATION = 1 << 6,
+        REBUILD_EUC_OUTPUTS  = 1 << 7,
+    };
+    uint32_t pendingRebuilds = 0;
+    int batchDepth = 0;                   // > 0 while beginBatch() is open
+
+    void requestRebuild(uint32_t flags);  // runs now, or at endBatch() inside a batch
+    void beginBatch();
+    void endBatch();
+    void flushRebuilds();
+
+    // Skips the set (and its listeners) when the value is already there
+    template<typename T, typename V>
+    void setIfChanged(ofParameter<T>& param, const V& value) {
+        if(param.get() != T(value)) param.set(T(value));
+    }
 
     // --- GUI Drawing Functions ---
     void drawPatternDisplay();
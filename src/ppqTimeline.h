@@ -5,6 +5,8 @@
 #include "ofxOceanodeShared.h"
 #include "imgui.h"
 #include "transportTrack.h"
+#include "transportClock.h"
+#include "sequencerContext.h"
 #include <cmath>
 #include <algorithm>
 #include <vector>
@@ -23,6 +25,7 @@ public:
 	}
 	
 	virtual ~ppqTimeline() {
+		clock.stop();
 		auto& tls = getTimelines();
 		tls.erase(std::remove(tls.begin(), tls.end(), this), tls.end());
 	}
@@ -43,6 +46,7 @@ public:
 		addParameterDropdown(clockMode, "Clock Mode", 0, {
 			"Internal", "External"
 		});
+		addParameter(clockThread.set("Clock Thread", false));
 
 		// ---------- Transport ----------
 		addSeparator("TRANSPORT",ofColor(240,240,240));
@@ -71,6 +75,10 @@ public:
 		addParameter(loopEndBeat.set("Loop End", 4.f, 0.f, FLT_MAX));
 		addParameter(wrapAtEnd.set("Wrap End", 1, 0, 1));
 
+		// ---------- Scheduler ----------
+		addSeparator("SCHEDULER",ofColor(240,240,240));
+		addParameter(lookaheadMs.set("Lookahead ms", 50.f, 0.f, 1000.f));
+
 		// ---------- UI ----------
 		addSeparator("GUI",ofColor(240,240,240));
 		addParameter(showWindow.set("Show", false));
@@ -96,10 +104,35 @@ public:
 		addOutputParameter(beatTransport.set("Beat Transport", 0.f, 0.f, FLT_MAX));
 		addOutputParameter(bar.set("Bar", 0, 0, INT_MAX));
 		addOutputParameter(barBeat.set("Bar Beat", 0.f, 0.f, FLT_MAX));
+		addOutputParameter(eventDelayOut.set("Ev Delay ms", {0}, {-FLT_MAX}, {FLT_MAX}));
+		addOutputParameter(eventTypeOut.set("Ev Type", {0}, {0}, {3}));
+		addOutputParameter(eventIndexOut.set("Ev Index", {0}, {0}, {127}));
+		addOutputParameter(eventValueOut.set("Ev Value", {0}, {0}, {1}));
+		eventDelayOut.setSerializable(false);
+		eventTypeOut.setSerializable(false);
+		eventIndexOut.setSerializable(false);
+		eventValueOut.setSerializable(false);
 
 		listeners.push(reset.newListener([this]() {
 			resetTransport();
 		}));
+
+		listeners.push(clockThread.newListener([this](bool &on) {
+			if(on){
+				syncClock();
+				clock.start(beatAcc);
+				pendingSeek = 0;
+			} else {
+				clock.stop();
+			}
+			// Internal timing re-bases from beatAcc on the next frame either way
+			transportRunning = false;
+		}));
+
+		// Hand the position back to the clock when leaving External mode
+		listeners.push(clockMode.newListener([this](int &mode) {
+			if(mode == 0 && clock.isRunning()) seekClock();
+		}));
 		
 		// Update zoom constraint when totalBars changes
 		listeners.push(totalBars.newListener([this](int &bars) {
@@ -120,6 +153,12 @@ public:
 	int getDenominator() const { return denominator; }
 	int getGridTicks() const { return gridTicks(); }
 	
+	// Latest clock thread snapshot ("Clock Thread" on). Extrapolate it with
+	// transportClock::extrapolate(snap, transportClock::nowMicros()) for the
+	// beat at any instant between frames; bpm is 0 while stopped.
+	bool hasClockThread() const { return clock.isRunning(); }
+	transportClock::Snapshot getClockSnapshot() const { return clock.read(); }
+
 	float getBpm() const { return bpm.get(); }
 	bool isPlaying() const { return play.get() == 1; }
 
@@ -130,6 +169,12 @@ public:
 	bool isLoopEnabled() const { return loopEnabled.get() == 1; }
 	double getLoopStart() const { return loopStartBeat.get(); }
 	double getLoopEnd() const { return loopEndBeat.get(); }
+
+	// Events scheduled this frame, sorted by due time (offs before ons on ties).
+	// Each batch covers the beats up to the next frame plus "Lookahead ms", so
+	// senders can emit on timeMs instead of on the frame that delivered them.
+	const std::vector<transportEvent>& getScheduledEvents() const { return eventBatch; }
+	ofEvent<std::vector<transportEvent>> scheduledEvents;
 		
 
 	// ---------- Clock ----------
@@ -165,38 +210,61 @@ public:
 				double expectedDelta = (bpm.get() / 60.0) * 0.1; // 100ms worth
 				if(delta > expectedDelta){
 					jumpTrigFramesRemaining = 3; // Stay high for 3 frames
+					scheduleDirty = true;
 				}
 			}
 			lastExternalBeat = beatAcc;
 		}
 		else{ // Internal
+			if(clock.isRunning()) syncClock();
+
 			if(play.get() == 0){
 				// Transport stopped - reset timing state when stopped
 				transportRunning = false;
+				eventBatch.clear();
+				dropSchedule(sequencerContext::get().nowMicros() / 1000.0);
+				publishEvents(sequencerContext::get().nowMicros() / 1000.0);
 				return;
 			}
 
-			uint64_t now = ofGetElapsedTimeMillis();
-			
-			// First frame after play starts
-			if(!transportRunning){
-				lastTimeMs = now;
-				beatAccBase = beatAcc; // Start from current position (preserves position on resume)
-				lastBpm = bpm.get();
-				transportRunning = true;
+			// The clock thread runs on wall time; offline renders use the
+			// sequencerContext path below
+			if(clock.isRunning() && !sequencerContext::get().isOffline()){
+				if(transportRunning){
+					// Back from an offline render: hand the position to the thread
+					transportRunning = false;
+					seekClock();
+				}
+				// The thread owns the position; read it extrapolated to this instant.
+				// Until it has applied our latest seek, hold the seek target.
+				transportClock::Snapshot snap = clock.read();
+				if(int32_t(snap.seekSeq - pendingSeek) >= 0){
+					beatAcc = transportClock::extrapolate(snap, transportClock::nowMicros());
+				}
 			}
+			else{
+				uint64_t now = sequencerContext::get().nowMicros();
 			
-			// Handle BPM changes
-			if(std::abs(bpm.get() - lastBpm) > 0.001f){
-				// BPM changed - snapshot current position as new base
-				beatAccBase = beatAcc;
-				lastTimeMs = now;
-				lastBpm = bpm.get();
-			}
+				// First frame after play starts
+				if(!transportRunning){
+					lastTimeUs = now;
+					beatAccBase = beatAcc; // Start from current position (preserves position on resume)
+					lastBpm = bpm.get();
+					transportRunning = true;
+				}
 			
-			// Calculate beats from elapsed time (drift-free)
-			double elapsedSeconds = (now - lastTimeMs) / 1000.0;
-			beatAcc = beatAccBase + (elapsedSeconds * (bpm.get() / 60.0));
+				// Handle BPM changes
+				if(std::abs(bpm.get() - lastBpm) > 0.001f){
+					// BPM changed - snapshot current position as new base
+					beatAccBase = beatAcc;
+					lastTimeUs = now;
+					lastBpm = bpm.get();
+				}
+			
+				// Calculate beats from elapsed time (drift-free)
+				double elapsedSeconds = (now - lastTimeUs) / 1000000.0;
+				beatAcc = beatAccBase + (elapsedSeconds * (bpm.get() / 60.0));
+			}
 		}
 
 		handleLoop(prev);
@@ -209,12 +277,13 @@ public:
 				// Update base to reflect the wrap
 				if(transportRunning){
 					beatAccBase = beatAcc;
-					lastTimeMs = ofGetElapsedTimeMillis();
+					lastTimeUs = sequencerContext::get().nowMicros();
 				}
 			}
 		}
 
 		updateOutputs();
+		scheduleEvents();
 
 	}
 	
@@ -386,7 +455,7 @@ private:
 					// Update base to reflect the loop jump
 					if(transportRunning){
 						beatAccBase = beatAcc;
-						lastTimeMs = ofGetElapsedTimeMillis();
+						lastTimeUs = sequencerContext::get().nowMicros();
 					}
 				}
 			}
@@ -398,9 +467,159 @@ private:
 		beatAccBase = 0.0;
 		lastExternalBeat = -1.0;
 		jumpTrigFramesRemaining = 0;
+		scheduleDirty = true;
+		if(clock.isRunning()) seekClock();
 		updateOutputs();
 	}
 
+	// --- Clock thread ---
+	// Parameters are pushed every frame; the thread picks them up on its next
+	// 1 ms tick. Loop and end wraps happen on the thread, so handleLoop() and
+	// the end wrap in update() only catch the sub-tick overshoot of an
+	// extrapolated read.
+	void syncClock(){
+		clock.setPlaying(play.get() == 1);
+		clock.setBpm(bpm.get());
+		clock.setLoop(loopEnabled.get() == 1, loopStartBeat.get(), loopEndBeat.get());
+		clock.setWrap(wrapAtEnd.get() == 1 ? totalBeats() : 0.0);
+	}
+
+	void seekClock(){
+		pendingSeek = clock.seek(beatAcc);
+	}
+
+	// --- Lookahead scheduler ---
+	// Every frame the beats from where the last window ended up to "now + one
+	// frame + lookahead" are collected from the subscribed tracks. The window is
+	// split at loop / end-of-timeline wraps (open events are flushed there, like
+	// the playhead jump drops active notes) and every event is stamped with the
+	// wall time it is due at, extrapolated at the current BPM.
+	void scheduleEvents(){
+		eventBatch.clear();
+		double nowMs = sequencerContext::get().nowMicros() / 1000.0;
+		double bps = bpm.get() / 60.0;
+		if(bps <= 0.0){
+			publishEvents(nowMs);
+			return;
+		}
+
+		double windowBeats = (ofGetLastFrameTime() * 1000.0 + lookaheadMs.get()) * bps / 1000.0;
+		double ahead = scheduleValid ? beatsAhead(beatAcc, scheduledBeat) : -1.0;
+		// A jump, or a horizon that no longer lines up with the playhead (loop
+		// edited, mode switched): drop what is open and restart at the playhead
+		if(scheduleDirty || ahead < 0.0 || ahead > windowBeats * 4.0 + 1.0){
+			dropSchedule(nowMs);
+			scheduledBeat = beatAcc;
+			scheduleValid = true;
+			scheduleDirty = false;
+			ahead = 0.0;
+		}
+
+		double b = scheduledBeat;
+		double t = nowMs + ahead / bps * 1000.0;
+		double remaining = windowBeats - ahead;
+		for(int pass = 0; remaining > 1e-9 && pass < MAX_WRAPS_PER_WINDOW; pass++){
+			double boundary = 0.0, target = 0.0;
+			bool wraps = nextWrap(b, boundary, target);
+			double segEnd = wraps ? std::min(b + remaining, boundary) : b + remaining;
+			collectWindow(b, segEnd, t, bps);
+			remaining -= segEnd - b;
+			t += (segEnd - b) / bps * 1000.0;
+			if(wraps && segEnd >= boundary){
+				flushTracks(boundary, t);
+				b = target;
+			} else {
+				b = segEnd;
+			}
+		}
+		scheduledBeat = b;
+
+		std::stable_sort(eventBatch.begin(), eventBatch.end(), [](const transportEvent& x, const transportEvent& y){
+			if(x.timeMs != y.timeMs) return x.timeMs < y.timeMs;
+			return x.isOff() && !y.isOff();
+		});
+		publishEvents(nowMs);
+	}
+
+	// Beats from the playhead forward to the schedule horizon, following at most
+	// one wrap; -1 if the horizon can't be reached from the playhead.
+	double beatsAhead(double from, double to) const {
+		if(to >= from) return to - from;
+		double ls = loopStartBeat.get(), le = loopEndBeat.get();
+		if(loopEnabled.get() == 1 && ls < le && from < le && to >= ls)
+			return (le - from) + (to - ls);
+		double totBeats = totalBeats();
+		if(wrapAtEnd.get() == 1 && totBeats > 0 && from < totBeats)
+			return (totBeats - from) + to;
+		return -1.0;
+	}
+
+	// Mirrors handleLoop() and the end wrap in update()
+	bool nextWrap(double beat, double& boundary, double& target) const {
+		double ls = loopStartBeat.get(), le = loopEndBeat.get();
+		if(loopEnabled.get() == 1 && ls < le && beat < le){
+			boundary = le;
+			target = ls;
+			return true;
+		}
+		double totBeats = totalBeats();
+		if(wrapAtEnd.get() == 1 && totBeats > 0 && beat < totBeats){
+			boundary = totBeats;
+			target = 0.0;
+			return true;
+		}
+		return false;
+	}
+
+	void collectWindow(double beatFrom, double beatTo, double timeFromMs, double bps){
+		for(auto* track : subscribedTracks){
+			size_t first = eventBatch.size();
+			track->collectEvents(beatFrom, beatTo, eventBatch);
+			for(size_t i = first; i < eventBatch.size(); i++){
+				eventBatch[i].timeMs = timeFromMs + (eventBatch[i].beat - beatFrom) / bps * 1000.0;
+				eventBatch[i].track = track;
+			}
+		}
+	}
+
+	void flushTracks(double beat, double timeMs){
+		for(auto* track : subscribedTracks){
+			size_t first = eventBatch.size();
+			track->flushEvents(beat, eventBatch);
+			for(size_t i = first; i < eventBatch.size(); i++){
+				eventBatch[i].timeMs = timeMs;
+				eventBatch[i].track = track;
+			}
+		}
+	}
+
+	void dropSchedule(double nowMs){
+		if(!scheduleValid) return;
+		flushTracks(beatAcc, nowMs);
+		scheduleValid = false;
+	}
+
+	void publishEvents(double nowMs){
+		if(eventBatch.empty() && !eventsPublished) return;
+		std::vector<float> delays, types, indices, values;
+		delays.reserve(eventBatch.size());
+		types.reserve(eventBatch.size());
+		indices.reserve(eventBatch.size());
+		values.reserve(eventBatch.size());
+		for(const auto& e : eventBatch){
+			delays.push_back(float(e.timeMs - nowMs));
+			types.push_back(float(e.type));
+			indices.push_back(float(e.index));
+			values.push_back(e.value);
+		}
+		eventDelayOut = delays;
+		eventTypeOut = types;
+		eventIndexOut = indices;
+		eventValueOut = values;
+		if(!eventBatch.empty()) ofNotifyEvent(scheduledEvents, eventBatch, this);
+		eventsPublished = !eventBatch.empty();
+	}
+
 	void updateOutputs(){
 		double beatsPerBar = double(numerator.get()) * (4.0 / double(denominator.get()));
 		
@@ -677,11 +896,13 @@ private:
 			if(dragMode == DRAG_NONE && clockMode.get() == 0){
 				beatAcc = beatAtMouse;
 				jumpTrigFramesRemaining = 3;
+				scheduleDirty = true;
 				
 				if(transportRunning){
 					beatAccBase = beatAcc;
-					lastTimeMs = ofGetElapsedTimeMillis();
+					lastTimeUs = sequencerContext::get().nowMicros();
 				}
+				if(clock.isRunning()) seekClock();
 				
 				updateOutputs();
 			}
@@ -737,11 +958,24 @@ private:
 	int jumpTrigFramesRemaining = 0;
 	
 	bool transportRunning = false;
-	uint64_t lastTimeMs = 0;
+	uint64_t lastTimeUs = 0;
 	double beatAccBase = 0.0;
 	double lastBpm = 120.0;
 
+	// Optional clock thread (Internal mode)
+	transportClock clock;
+	uint32_t pendingSeek = 0;  // last seek() the main thread is waiting on
+
+	// Scheduler state
+	static constexpr int MAX_WRAPS_PER_WINDOW = 64;
+	std::vector<transportEvent> eventBatch;
+	double scheduledBeat = 0.0;  // where the last collected window ended
+	bool scheduleValid = false;
+	bool scheduleDirty = true;
+	bool eventsPublished = false;
+
 	ofParameter<int> clockMode;
+	ofParameter<bool> clockThread;
 	ofParameter<int> ppqInput;
 	ofParameter<float> beatTransportInput;
 
@@ -757,6 +991,7 @@ private:
 	ofParameter<float> loopStartBeat;
 	ofParameter<float> loopEndBeat;
 	ofParameter<int> wrapAtEnd;
+	ofParameter<float> lookaheadMs;
 
 	ofParameter<bool> showWindow;
 	ofParameter<int>  zoomBars;
@@ -774,6 +1009,10 @@ private:
 	ofParameter<int>   bar;
 	ofParameter<float> barBeat;
 	ofParameter<int>   jumpTrig;
+	ofParameter<vector<float>> eventDelayOut;
+	ofParameter<vector<float>> eventTypeOut;
+	ofParameter<vector<float>> eventIndexOut;
+	ofParameter<vector<float>> eventValueOut;
 
 	ofEventListeners listeners;
 };
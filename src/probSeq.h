@@ -2,6 +2,7 @@
 #define probSeq_h
 
 #include "ofxOceanodeNodeModel.h"
+#include "sequencerContext.h"
 #include <random>
 #include <climits>    // INT_MAX
 #include <algorithm>  // std::clamp
@@ -10,7 +11,7 @@ class probSeq : public ofxOceanodeNodeModel {
 public:
 	probSeq()
 	: ofxOceanodeNodeModel("Probabilistic Step Sequencer")
-	, gen(rd())
+	, gen(this)
 	, dist(0.0, 1.0) {}
 
 	~probSeq() {}
@@ -64,8 +65,7 @@ private:
 	int lastIndex = -1;
 
 	// RNG
-	std::random_device rd;
-	std::mt19937 gen;
+	sequencerRng gen;
 	std::uniform_real_distribution<double> dist;
 
 	void updateOutput() {
@@ -98,7 +98,7 @@ private:
 		if (seed.get() != 0) {
 			gen.seed(static_cast<uint32_t>(seed.get()));
 		} else {
-			gen.seed(rd()); // non-deterministic seed
+			gen.follow(); // sequencerContext seed (random unless rendering offline)
 		}
 	}
 };
@@ -11,8 +11,8 @@
 #define rateLimiter_h
 
 #include "ofxOceanodeNodeModel.h"
+#include "timerService.h"
 #include <mutex>
-#include <chrono>
 
 class rateLimiter : public ofxOceanodeNodeModel {
 public:
@@ -51,23 +51,30 @@ public:
 		if(!shouldUpdate) return;
 		
 		// Apply rate limiting (speedlim behavior)
-		uint64_t currentTime = getCurrentTimeMs();
-		float minInterval = minIntervalMs.get();
+		uint64_t currentTime = timerService::nowMicros();
+		uint64_t minInterval = uint64_t(minIntervalMs.get() * 1000.0f);
 		
-		if(minInterval <= 0.0f) {
+		if(minInterval == 0) {
 			// No rate limiting - output at 60fps
+			timer.cancel(0);
+			output = safeData;
+			lastOutputTime = currentTime;
+		} else if(currentTime - lastOutputTime >= minInterval) {
+			// Enough time passed - allow output
+			timer.cancel(0);
 			output = safeData;
 			lastOutputTime = currentTime;
 		} else {
-			// Check if enough time has elapsed since last output
-			uint64_t elapsed = currentTime - lastOutputTime;
-			
-			if(elapsed >= minInterval) {
-				// Enough time passed - allow output
-				output = safeData;
-				lastOutputTime = currentTime;
+			// Too soon - hold the latest value and send it when the interval
+			// ends (speedlim), measured from the scheduled time so the output
+			// rate isn't stretched by frame lateness
+			pendingData = std::move(safeData);
+			if(!timer.isPending(0)) {
+				timer.atTime(0, lastOutputTime + minInterval, [this](uint64_t scheduled, uint64_t) {
+					output = pendingData;
+					lastOutputTime = scheduled;
+				});
 			}
-			// else: too soon - skip this update (acts like speedlim)
 		}
 	}
 	
@@ -82,13 +89,9 @@ private:
 	vector<float> latestData;
 	bool hasNewData = false;
 	
-	uint64_t lastOutputTime;
-	
-	uint64_t getCurrentTimeMs() {
-		return std::chrono::duration_cast<std::chrono::milliseconds>(
-			std::chrono::steady_clock::now().time_since_epoch()
-		).count();
-	}
+	uint64_t lastOutputTime;  // microseconds, timerService::nowMicros() clock
+	vector<float> pendingData;  // latest value held back by the speed limit
+	nodeTimers timer;           // trailing output (key 0)
 };
 
 #endif /* rateLimiter_h */
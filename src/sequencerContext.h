@@ -0,0 +1,157 @@
+#ifndef sequencerContext_h
+#define sequencerContext_h
+
+#include "ofxOceanodeNodeModel.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+
+// Clock and seed source for the sequencing nodes (and timerService).
+//
+// Live (default): steady clock, OF frame count and nondeterministic seeds,
+// i.e. what the nodes did on their own before. Both clocks count from
+// CLOCK_EPOCH_US rather than 0, which nodes use as "unset", and stay small
+// enough for float seconds.
+// Offline: a driver fixes the seed and steps a virtual clock, so a graph can
+// be rendered faster than real time and gives bit-identical output on every
+// run:
+//
+//     auto &ctx = sequencerContext::get();
+//     ctx.beginOffline(1234);
+//     for(int i = 0; i < frames; i++) ctx.step(1000000 / 60);
+//     ctx.endOffline();
+//
+// Start offline renders from a freshly loaded or stopped graph: timers armed
+// on the live clock stay pending until the live clock reaches them again.
+class sequencerContext {
+public:
+	static constexpr uint64_t CLOCK_EPOCH_US = 1000000;
+
+	static sequencerContext& get() {
+		static sequencerContext instance;
+		return instance;
+	}
+
+	// ---- Clock ----
+	uint64_t nowMicros() const {
+		if(offline.load(std::memory_order_acquire)) return virtualUs.load(std::memory_order_acquire);
+		return CLOCK_EPOCH_US + std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - liveStart
+		).count();
+	}
+	uint64_t nowMillis() const { return nowMicros() / 1000; }
+	float nowSeconds() const { return float(nowMicros() / 1e6); }
+
+	uint64_t frameNum() const {
+		return offline.load(std::memory_order_acquire) ? virtualFrame.load(std::memory_order_acquire) : ofGetFrameNum();
+	}
+
+	// ---- Offline driver (main thread) ----
+	void beginOffline(uint32_t seed) {
+		fixedSeed = seed;
+		virtualUs = CLOCK_EPOCH_US;
+		virtualFrame = 0;
+		offline.store(true, std::memory_order_release);
+		generationCounter++;
+	}
+
+	void endOffline() {
+		offline.store(false, std::memory_order_release);
+		generationCounter++;
+	}
+
+	bool isOffline() const { return offline.load(std::memory_order_acquire); }
+
+	// Advances the virtual clock by one frame of `us` and runs the update pass
+	void step(uint64_t us) {
+		if(!isOffline()) return;
+		virtualUs += us;
+		virtualFrame++;
+		ofEvents().notifyUpdate();
+	}
+
+	// ---- Seeds ----
+	// Changes whenever seeding changes (begin / end offline); engines reseed on it
+	uint32_t generation() const { return generationCounter.load(std::memory_order_acquire); }
+
+	// Offline: a fixed function of the seed and the key. Live: random.
+	uint32_t seedFor(const std::string &key) const {
+		if(!isOffline()) return std::random_device{}();
+		uint32_t h = 2166136261u;  // FNV-1a
+		for(unsigned char c : key) h = (h ^ c) * 16777619u;
+		uint64_t z = (uint64_t(fixedSeed) << 32 | h) + 0x9e3779b97f4a7c15ull;  // splitmix64
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return uint32_t(z ^ (z >> 31));
+	}
+
+private:
+	std::atomic<bool>     offline{false};
+	std::atomic<uint64_t> virtualUs{CLOCK_EPOCH_US};
+	std::atomic<uint64_t> virtualFrame{0};
+	std::atomic<uint32_t> generationCounter{1};
+	uint32_t fixedSeed = 0;
+	const std::chrono::steady_clock::time_point liveStart = std::chrono::steady_clock::now();
+
+	sequencerContext() = default;
+};
+
+// Random engine of one node, seeded from sequencerContext. It is keyed by the
+// node's name and numeric identifier, so in offline mode every node gets its
+// own stream that doesn't depend on creation order or on the other nodes.
+// Drop-in for std::mt19937 with the <random> distributions.
+class sequencerRng {
+public:
+	using result_type = std::mt19937::result_type;
+
+	explicit sequencerRng(ofxOceanodeNodeModel *owner) : owner(owner) {}
+
+	static constexpr result_type min() { return std::mt19937::min(); }
+	static constexpr result_type max() { return std::mt19937::max(); }
+
+	result_type operator()() {
+		sync();
+		return engine();
+	}
+
+	// Pins the engine to a node's own Seed parameter; it is re-applied when
+	// an offline render starts so renders stay reproducible
+	void seed(result_type s) {
+		pinnedSeed = s;
+		pinned = true;
+		engine.seed(s);
+		seededGeneration = sequencerContext::get().generation();
+	}
+
+	// Back to context seeding (e.g. Seed parameter set to 0)
+	void follow() {
+		pinned = false;
+		seededGeneration = 0;
+	}
+
+	// Same ranges as ofRandom(max) / ofRandom(x, y)
+	float uniform(float range) { return uniform(0.0f, range); }
+	float uniform(float x, float y) {
+		float lo = std::min(x, y), hi = std::max(x, y);
+		return lo + std::uniform_real_distribution<float>(0.0f, 1.0f)(*this) * (hi - lo);
+	}
+
+private:
+	ofxOceanodeNodeModel *owner;
+	std::mt19937 engine;
+	uint32_t seededGeneration = 0;  // generations start at 1
+	result_type pinnedSeed = 0;
+	bool pinned = false;
+
+	void sync() {
+		uint32_t g = sequencerContext::get().generation();
+		if(g == seededGeneration) return;
+		seededGeneration = g;
+		engine.seed(pinned ? pinnedSeed : sequencerContext::get().seedFor(owner->nodeName() + "/" + ofToString(owner->getNumIdentifier())));
+	}
+};
+
+#endif /* sequencerContext_h */
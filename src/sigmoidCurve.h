@@ -4,6 +4,7 @@
 #include "ofxOceanodeNodeModel.h"
 #include "ofxOceanodeShared.h"
 #include "imgui.h"
+#include "curveSegmentCache.h"
 #include <algorithm>
 #include <cmath>
 
@@ -37,6 +38,7 @@ public:
 		
 		addParameter(minValue.set("Min Value", 0.0f, -10.0f, 10.0f));
 		addParameter(maxValue.set("Max Value", 1.0f, -10.0f, 10.0f));
+		addParameter(lutResolution.set("LUT Res", 0, 0, 4096));
 		
 		addParameter(showEditor.set("Show Editor", false));
 		auto curveEditorRegionRef = addCustomRegion(curveEditorRegion.set("Curve Editor", [this](){
@@ -58,6 +60,10 @@ public:
 		listeners.push(numCurves.newListener([this](int &val){
 			resizeCurves(val);
 		}));
+		listeners.push(lutResolution.newListener([this](int &val){
+			invalidateCurve(-1);
+			updateCurveOutput();
+		}));
 		listeners.push(phasorInput.newListener([this](vector<float> &val){
 			updateCurveOutput();
 		}));
@@ -95,6 +101,7 @@ private:
 	ofParameter<int> gridDivisions;
 	ofParameter<float> minValue;
 	ofParameter<float> maxValue;
+	ofParameter<int> lutResolution;   // samples per segment, 0 = evaluate exactly
 	ofParameter<bool> showEditor;
 	customGuiRegion curveEditorRegion;
 	ofParameter<vector<float>> curveOutput;
@@ -102,6 +109,7 @@ private:
 	// Multiple curves data
 	std::vector<std::vector<SigmoidControlPoint>> allCurvePoints;
 	std::vector<std::vector<SigmoidTension>> allSigmoidTensions;
+	std::vector<curveSegmentCache> curveCaches; // one per curve, rebuilt when its points/tensions change
 	int activeCurve = 0;
 	
 	ofEventListeners listeners;
@@ -471,6 +479,7 @@ private:
 					newSteepness,
 					0.05f, 10.0f
 				);
+				invalidateCurve(activeCurve);
 			}
 		}
 		
@@ -558,55 +567,33 @@ private:
 		curveOutput = outputs;
 	}
 	
-	float sigmoidFlex(float x, float p, float k) {
-		x = ofClamp(x, 0.0f, 1.0f);
-		p = ofClamp(p, 0.01f, 0.99f);
-		k = ofClamp(k, 0.05f, 10.0f);
-		
-		const float epsilon = 0.0001f;
-		if(x < epsilon) return 0.0f;
-		if(x > 1.0f - epsilon) return 1.0f;
-		
-		float xSafe = ofClamp(x, epsilon, 1.0f - epsilon);
-		float pSafe = ofClamp(p, epsilon, 1.0f - epsilon);
-		
-		float a = pow(xSafe / pSafe, k);
-		float b = pow((1.0f - xSafe) / (1.0f - pSafe), k);
-		
-		float denominator = a + b;
-		if(denominator < epsilon) return 0.5f;
-		
-		return a / denominator;
-	}
-	
 	float evaluateSegment(const SigmoidControlPoint& p1, const SigmoidControlPoint& p2, const SigmoidTension& tension, float t) {
-		float curveValue = sigmoidFlex(t, tension.inflection, tension.steepness);
+		float curveValue = curveSegmentCache::sigmoidFlex(t, tension.inflection, tension.steepness);
 		return p1.value + curveValue * (p2.value - p1.value);
 	}
 	
 	float evaluateCurveAt(double position, int curveIdx) {
 		if(curveIdx < 0 || curveIdx >= allCurvePoints.size()) return 0.0f;
-		
-		auto& points = allCurvePoints[curveIdx];
-		auto& tensions = allSigmoidTensions[curveIdx];
-		
-		if(points.empty()) return 0.0f;
-		if(points.size() == 1) return points[0].value;
-		
-		if(position <= points.front().position) return points.front().value;
-		if(position >= points.back().position) return points.back().value;
-		
-		for(size_t i = 0; i < points.size() - 1; i++) {
-			if(position >= points[i].position && position <= points[i + 1].position) {
-				double segmentLength = points[i + 1].position - points[i].position;
-				if(segmentLength < 0.001) return points[i].value;
-				
-				float t = (position - points[i].position) / segmentLength;
-				return evaluateSegment(points[i], points[i + 1], tensions[i], t);
-			}
+		if(curveCaches.size() != allCurvePoints.size()) curveCaches.resize(allCurvePoints.size());
+		
+		auto& cache = curveCaches[curveIdx];
+		if(cache.isDirty()) {
+			static const std::vector<SigmoidTension> noTensions;
+			cache.build(allCurvePoints[curveIdx],
+						curveIdx < allSigmoidTensions.size() ? allSigmoidTensions[curveIdx] : noTensions,
+						[](const SigmoidControlPoint& pt) { return pt.position; },
+						lutResolution.get());
+		}
+		return cache.evaluate(position);
+	}
+	
+	// Call after points or tensions of a curve change (-1 = all curves)
+	void invalidateCurve(int curveIdx) {
+		if(curveIdx < 0) {
+			for(auto& cache : curveCaches) cache.invalidate();
+		} else if(curveIdx < curveCaches.size()) {
+			curveCaches[curveIdx].invalidate();
 		}
-		
-		return points.back().value;
 	}
 	
 	void rebuildTensions(int curveIdx) {
@@ -623,6 +610,8 @@ private:
 		while(tensions.size() > neededTensions) {
 			tensions.pop_back();
 		}
+		
+		invalidateCurve(curveIdx);
 	}
 	
 	int findClosestSegment(ImVec2 mouse, ImVec2 trackPos,
@@ -687,6 +676,7 @@ private:
 			allCurvePoints.pop_back();
 			allSigmoidTensions.pop_back();
 		}
+		invalidateCurve(-1);
 		
 		if(activeCurve >= newNumCurves) {
 			activeCurve = newNumCurves - 1;
@@ -787,6 +777,7 @@ private:
 				allSigmoidTensions.push_back(curveTensions);
 			}
 		}
+		invalidateCurve(-1);
 		
 		if(json.count("activeCurve") > 0) {
 			activeCurve = json["activeCurve"];
@@ -241,6 +241,30 @@ public:
         }
     }
 
+    // Block rendering — single channel, walks the step map across each clip pass
+    int getRenderChannelCount() const override { return 1; }
+
+    bool renderBlock(int channel, double beatFrom, double beatTo, int numSamples, float* out) override {
+        if(channel != 0 || numSamples <= 0) return false;
+        float  lo    = outMin.get();
+        float  range = outMax.get() - outMin.get();
+        double step  = std::max(0.0, beatTo - beatFrom) / numSamples;
+        double cs0   = getClipStartAt(0); // steps are in primary clip space
+        std::fill(out, out + numSamples, lo);
+
+        forEachClipRun(beatFrom, step, numSamples, [&](int i0, int i1, double base) {
+            double x0 = cs0 + (beatFrom - base) + i0 * step;
+            auto it = steps.upper_bound((int64_t)std::round(x0 * (double)TICKS_PER_BEAT));
+            for(int i = i0; i < i1; i++) {
+                int64_t tick = (int64_t)std::round((x0 + (i - i0) * step) * (double)TICKS_PER_BEAT);
+                while(it != steps.end() && it->first <= tick) ++it;
+                float v = (it == steps.begin()) ? 0.f : std::prev(it)->second;
+                out[i] = lo + v * range;
+            }
+        });
+        return true;
+    }
+
     // Clip window virtuals
     bool   hasClipWindow()        const override { return true; }
     double getClipStart()         const override { return clipStart.get(); }
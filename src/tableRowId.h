@@ -3,8 +3,8 @@
 #define TABLEROWID_H
 
 #include "ofxOceanodeNodeModel.h"
+#include "csvParser.h"
 #include <fstream>
-#include <sstream>
 #include <vector>
 #include <limits>
 
@@ -89,28 +89,13 @@ public:
     
     // Read file and update fileContent vector
     void readFile() {
-        std::ifstream file(currentFilePath);
-        if (!file.is_open()) {
+        csvParseReport report;
+        if (!csvParser::parseFile(currentFilePath, fileContent, report)) {
             ofLogError("Table") << "Failed to open file at " << currentFilePath;
             return;
         }
-        std::string line;
-        fileContent.clear();
-        while (std::getline(file, line)) {
-            std::istringstream iss(line);
-            std::string value;
-            std::vector<float> rowValues;
-            while (std::getline(iss, value, ',')) { //use comma as separator between values
-                try {
-                    float val = std::stof(value);
-                    rowValues.push_back(val);
-                } catch (std::invalid_argument const &e) {
-                    ofLogWarning("Table") << "Failed to convert string to float: " << value;
-                } catch (std::out_of_range const &e) {
-                    ofLogWarning("Table") << "Float out of range: " << value;
-                }
-            }
-            fileContent.push_back(rowValues);
+        if (!report.ok()) {
+            ofLogWarning("Table") << currentFilePath << ": " << report.describe();
         }
         
         rowSize = static_cast<int>(fileContent.size());
@@ -142,7 +127,7 @@ public:
             ofLogError("Table") << "Failed to open file for writing at " << path;
             return;
         }
-        for (auto & rRow : fileContent) {
+        for (const auto & rRow : fileContent) {
             for (size_t i = 0; i < rRow.size(); ++i) {
                 file << rRow[i];
                 if (i < rRow.size() - 1) file << ","; //use comma as separator between values
@@ -159,7 +144,7 @@ public:
                 fileContent.push_back(input.get());
             } else {
                 // Replacing an existing row
-                fileContent[wRow.get()] = input.get();
+                fileContent.setRow(wRow.get(), input.get());
             }
 
             // Write the modified content back to the file
@@ -178,7 +163,7 @@ public:
     void adjustRColBasedOnFilter(string& filter) {
         if (fileContent.empty()) return; // Ensure there's data
 
-        auto& headerRow = fileContent.front(); // Assuming the first row contains headers
+        auto headerRow = fileContent.front(); // Assuming the first row contains headers
 
         // Convert header row values to strings and search for a match with 'filter'
         for (size_t colIndex = 0; colIndex < headerRow.size(); ++colIndex) {
@@ -236,7 +221,7 @@ public:
     
     void updateRowOutput(int rowNum) {
            if (rowNum >= 0 && rowNum < fileContent.size()) {
-               outputRow.set(fileContent[rowNum]);
+               outputRow.set(fileContent[rowNum].toVector());
                // Call updateColumnOutput to refresh column data based on the current rCol
                updateColumnOutput();
            } else {
@@ -281,7 +266,7 @@ private:
     
 
     std::string currentFilePath;
-    std::vector<std::vector<float>> fileContent;
+    csvTable fileContent;
 };
 
 #endif /* TABLEROWID_H */
@@ -0,0 +1,212 @@
+#ifndef timerService_h
+#define timerService_h
+
+#include "ofMain.h"
+#include "sequencerContext.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Process-wide deadline service for time-based nodes.
+//
+// Nodes register a callback for a point in time (sequencerContext clock,
+// microseconds) or for a frame number instead of scanning their own timers
+// every update(). Deadlines live in two min-heaps that are polled once per frame, before the
+// app's update, so a frame with nothing due costs one comparison per heap.
+// Insert is O(log n); cancel is O(1) and leaves a stale heap entry behind that
+// is skipped when it surfaces. Callbacks receive the deadline they were
+// scheduled for along with the time they actually ran, so nodes can measure
+// from the intended instant instead of the late frame.
+//
+// Main thread only: schedule, cancel and callbacks all run on it.
+class timerService {
+public:
+	using TimerId = uint64_t;  // 0 never names a timer
+	// (scheduled, now): microseconds for time timers, frame numbers for frame timers
+	using Callback = std::function<void(uint64_t, uint64_t)>;
+
+	static timerService& get() {
+		static timerService instance;
+		return instance;
+	}
+
+	// Same clock the time timers are scheduled on
+	static uint64_t nowMicros() { return sequencerContext::get().nowMicros(); }
+	static uint64_t frameNum() { return sequencerContext::get().frameNum(); }
+
+	TimerId atTime(uint64_t dueUs, Callback cb) { return insert(timeHeap, dueUs, std::move(cb)); }
+	TimerId afterMs(double ms, Callback cb) {
+		return atTime(nowMicros() + uint64_t(std::max(0.0, ms) * 1000.0), std::move(cb));
+	}
+	TimerId atFrame(uint64_t frame, Callback cb) { return insert(frameHeap, frame, std::move(cb)); }
+
+	// Resets id to 0; unknown or already fired ids are ignored
+	void cancel(TimerId& id) {
+		Slot* s = lookup(id);
+		id = 0;
+		if(!s) return;
+		release(uint32_t(s - slots.data()));
+	}
+
+	bool isPending(TimerId id) const {
+		uint32_t idx = uint32_t(id & 0xffffffffu);
+		return idx > 0 && idx <= slots.size() && slots[idx - 1].active && slots[idx - 1].gen == uint32_t(id >> 32);
+	}
+
+	size_t size() const { return live; }
+
+	// Fires everything due at nowUs / frame in deadline order. Timers scheduled
+	// by a callback wait for the next poll even when already due.
+	void poll(uint64_t nowUs, uint64_t frame) {
+		uint64_t seqLimit = nextSeq;
+		drain(timeHeap, nowUs, seqLimit);
+		drain(frameHeap, frame, seqLimit);
+	}
+
+private:
+	struct Slot {
+		Callback cb;
+		uint32_t gen = 1;
+		bool active = false;
+	};
+
+	struct Entry {
+		uint64_t due;
+		uint64_t seq;   // FIFO among equal deadlines
+		uint32_t slot;
+		uint32_t gen;
+	};
+
+	// std heap functions build a max-heap; invert for earliest-first
+	struct Later {
+		bool operator()(const Entry& a, const Entry& b) const {
+			return a.due != b.due ? a.due > b.due : a.seq > b.seq;
+		}
+	};
+
+	std::vector<Slot>     slots;
+	std::vector<uint32_t> freeSlots;
+	std::vector<Entry>    timeHeap;
+	std::vector<Entry>    frameHeap;
+	uint64_t nextSeq = 0;
+	size_t   live = 0;
+	ofEventListener updateListener;
+
+	timerService() {
+		updateListener = ofEvents().update.newListener([this](ofEventArgs&) {
+			poll(nowMicros(), frameNum());
+		}, OF_EVENT_ORDER_BEFORE_APP);
+	}
+
+	TimerId insert(std::vector<Entry>& heap, uint64_t due, Callback cb) {
+		uint32_t idx;
+		if(!freeSlots.empty()) {
+			idx = freeSlots.back();
+			freeSlots.pop_back();
+		} else {
+			idx = uint32_t(slots.size());
+			slots.emplace_back();
+		}
+		Slot& s = slots[idx];
+		s.cb = std::move(cb);
+		s.active = true;
+		live++;
+
+		heap.push_back({due, nextSeq++, idx, s.gen});
+		std::push_heap(heap.begin(), heap.end(), Later());
+		compact(heap);
+		return (TimerId(s.gen) << 32) | (idx + 1);
+	}
+
+	Slot* lookup(TimerId id) {
+		return isPending(id) ? &slots[uint32_t(id & 0xffffffffu) - 1] : nullptr;
+	}
+
+	// Bumping the generation orphans the slot's heap entry
+	void release(uint32_t idx) {
+		Slot& s = slots[idx];
+		s.cb = nullptr;
+		s.active = false;
+		s.gen++;
+		freeSlots.push_back(idx);
+		live--;
+	}
+
+	void drain(std::vector<Entry>& heap, uint64_t now, uint64_t seqLimit) {
+		while(!heap.empty() && heap.front().due <= now && heap.front().seq < seqLimit) {
+			Entry e = heap.front();
+			std::pop_heap(heap.begin(), heap.end(), Later());
+			heap.pop_back();
+
+			Slot& s = slots[e.slot];
+			if(!s.active || s.gen != e.gen) continue;  // cancelled
+			// Move the callback out first: it may schedule or cancel, which can
+			// reuse this slot or grow the slot vector
+			Callback cb = std::move(s.cb);
+			release(e.slot);
+			cb(e.due, now);
+		}
+	}
+
+	// Drop cancelled entries once they outnumber the live ones
+	void compact(std::vector<Entry>& heap) {
+		if(heap.size() < 256 || heap.size() < 4 * live) return;
+		heap.erase(std::remove_if(heap.begin(), heap.end(), [this](const Entry& e) {
+			return !slots[e.slot].active || slots[e.slot].gen != e.gen;
+		}), heap.end());
+		std::make_heap(heap.begin(), heap.end(), Later());
+	}
+};
+
+// The timers of one node, one per key (usually the vector index). Arming a key
+// replaces its pending timer, and everything still pending is cancelled when
+// the owner is destroyed, so callbacks can safely capture `this`.
+class nodeTimers {
+public:
+	nodeTimers() = default;
+	nodeTimers(const nodeTimers&) = delete;
+	nodeTimers& operator=(const nodeTimers&) = delete;
+	~nodeTimers() { cancelAll(); }
+
+	void atTime(size_t key, uint64_t dueUs, timerService::Callback cb) {
+		cancel(key);
+		slot(key) = timerService::get().atTime(dueUs, wrap(key, std::move(cb)));
+	}
+
+	void atFrame(size_t key, uint64_t frame, timerService::Callback cb) {
+		cancel(key);
+		slot(key) = timerService::get().atFrame(frame, wrap(key, std::move(cb)));
+	}
+
+	void cancel(size_t key) {
+		if(key < ids.size() && ids[key] != 0) timerService::get().cancel(ids[key]);
+	}
+
+	// Cancels every key >= first (for vectors that shrank)
+	void cancelFrom(size_t first) {
+		for(size_t k = first; k < ids.size(); k++) cancel(k);
+		if(first < ids.size()) ids.resize(first);
+	}
+
+	void cancelAll() { cancelFrom(0); }
+
+	bool isPending(size_t key) const { return key < ids.size() && ids[key] != 0; }
+
+private:
+	std::vector<timerService::TimerId> ids;
+
+	timerService::TimerId& slot(size_t key) {
+		if(key >= ids.size()) ids.resize(key + 1, 0);
+		return ids[key];
+	}
+
+	timerService::Callback wrap(size_t key, timerService::Callback cb) {
+		return [this, key, cb = std::move(cb)](uint64_t due, uint64_t now) {
+			ids[key] = 0;
+			cb(due, now);
+		};
+	}
+};
+
+#endif /* timerService_h */
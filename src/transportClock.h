@@ -0,0 +1,165 @@
+#ifndef transportClock_h
+#define transportClock_h
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+// Dedicated clock thread for ppqTimeline's internal mode.
+//
+// Every millisecond the thread advances the beat by the exact elapsed time on
+// a monotonic microsecond clock, applies tempo changes, seeks and loop / end
+// wraps, and publishes (beat, bpm, timestamp) through a seqlock. Readers never
+// block: they take the latest consistent snapshot and extrapolate it to their
+// own "now", so the position they see doesn't depend on frame pacing.
+class transportClock {
+public:
+	struct Snapshot {
+		double   beat = 0.0;
+		double   bpm = 0.0;     // 0 while stopped
+		int64_t  timeUs = 0;    // nowMicros() the beat was taken at
+		uint32_t seekSeq = 0;   // last seek() the beat includes
+	};
+
+	static int64_t nowMicros() {
+		using namespace std::chrono;
+		return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	transportClock() = default;
+	transportClock(const transportClock&) = delete;
+	transportClock& operator=(const transportClock&) = delete;
+	~transportClock() { stop(); }
+
+	void start(double beat) {
+		if(running) return;
+		seekBeat = beat;
+		Snapshot s;
+		s.beat = beat;
+		s.timeUs = nowMicros();
+		s.seekSeq = seekSeq.load();
+		publish(s);
+		running = true;
+		worker = std::thread([this]() { run(); });
+	}
+
+	void stop() {
+		if(!running) return;
+		running = false;
+		if(worker.joinable()) worker.join();
+	}
+
+	bool isRunning() const { return running; }
+
+	// ---- Commands (main thread) ----
+	void setPlaying(bool p)  { playing = p; }
+	void setBpm(double b)    { bpm = b; }
+	void setLoop(bool enabled, double start, double end) {
+		loopEnabled = enabled;
+		loopStart = start;
+		loopEnd = end;
+	}
+	void setWrap(double totalBeats) { wrapBeats = totalBeats; } // <= 0 disables
+	// Returns the seek's sequence number; snapshots with seekSeq >= it include it
+	uint32_t seek(double beat) {
+		seekBeat = beat;
+		return seekSeq.fetch_add(1) + 1;
+	}
+
+	// ---- Readers (any thread) ----
+	Snapshot read() const {
+		Snapshot s;
+		uint32_t before, after;
+		do {
+			before = sequence.load(std::memory_order_acquire);
+			s.beat    = snapBeat.load(std::memory_order_relaxed);
+			s.bpm     = snapBpm.load(std::memory_order_relaxed);
+			s.timeUs  = snapTime.load(std::memory_order_relaxed);
+			s.seekSeq = snapSeek.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after = sequence.load(std::memory_order_relaxed);
+		} while((before & 1) || before != after);
+		return s;
+	}
+
+	// Snapshot beat extrapolated to timeUs (loop / end wraps are left to the caller)
+	static double extrapolate(const Snapshot& s, int64_t timeUs) {
+		return s.beat + double(timeUs - s.timeUs) * s.bpm / 60e6;
+	}
+
+private:
+	static constexpr int TICK_US = 1000;
+
+	std::thread       worker;
+	std::atomic<bool> running{false};
+
+	// commands
+	std::atomic<bool>     playing{false};
+	std::atomic<double>   bpm{120.0};
+	std::atomic<bool>     loopEnabled{false};
+	std::atomic<double>   loopStart{0.0};
+	std::atomic<double>   loopEnd{0.0};
+	std::atomic<double>   wrapBeats{0.0};
+	std::atomic<double>   seekBeat{0.0};
+	std::atomic<uint32_t> seekSeq{0};
+
+	// seqlock-published snapshot
+	std::atomic<uint32_t> sequence{0};
+	std::atomic<double>   snapBeat{0.0};
+	std::atomic<double>   snapBpm{0.0};
+	std::atomic<int64_t>  snapTime{0};
+	std::atomic<uint32_t> snapSeek{0};
+
+	void publish(const Snapshot& s) {
+		uint32_t seq = sequence.load(std::memory_order_relaxed);
+		sequence.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		snapBeat.store(s.beat, std::memory_order_relaxed);
+		snapBpm.store(s.bpm, std::memory_order_relaxed);
+		snapTime.store(s.timeUs, std::memory_order_relaxed);
+		snapSeek.store(s.seekSeq, std::memory_order_relaxed);
+		sequence.store(seq + 2, std::memory_order_release);
+	}
+
+	void run() {
+		Snapshot s = read();
+		uint32_t seenSeek = s.seekSeq;
+		double   tickBpm = s.bpm;
+		auto next = std::chrono::steady_clock::now();
+
+		while(running) {
+			int64_t now = nowMicros();
+			// Advance by the exact elapsed time at the tempo of the last tick,
+			// so the beat never drifts from the monotonic clock
+			double beat = s.beat + double(now - s.timeUs) * tickBpm / 60e6;
+
+			uint32_t seq = seekSeq.load(std::memory_order_acquire);
+			if(seq != seenSeek) {
+				seenSeek = seq;
+				beat = seekBeat.load();
+			} else {
+				// Same rules as ppqTimeline::handleLoop() and its end wrap
+				double ls = loopStart.load(), le = loopEnd.load();
+				if(loopEnabled.load() && ls < le && s.beat < le && beat >= le) beat = ls + (beat - le);
+				double tot = wrapBeats.load();
+				if(tot > 0.0 && beat >= tot) beat = std::fmod(beat, tot);
+			}
+
+			tickBpm = playing.load() ? bpm.load() : 0.0;
+			s.beat = beat;
+			s.bpm = tickBpm;
+			s.timeUs = now;
+			s.seekSeq = seenSeek;
+			publish(s);
+
+			next += std::chrono::microseconds(TICK_US);
+			auto wallNow = std::chrono::steady_clock::now();
+			if(next < wallNow - std::chrono::milliseconds(50)) next = wallNow; // don't burst after a stall
+			std::this_thread::sleep_until(next);
+		}
+	}
+};
+
+#endif /* transportClock_h */
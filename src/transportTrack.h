@@ -3,6 +3,27 @@
 
 #include "imgui.h"
 #include "ofMain.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
+
+class transportTrack;
+
+// A discrete event produced by a track inside a scheduled beat window.
+// Tracks fill in beat/type/index/value; the timeline stamps timeMs and track.
+struct transportEvent {
+	enum Type { NoteOn, NoteOff, GateOn, GateOff };
+	double beat   = 0.0;  // global beat the event falls on
+	double timeMs = 0.0;  // sequencerContext::nowMicros() / 1000 at which the event is due
+	Type   type   = NoteOn;
+	int    index  = 0;    // pitch for notes, lane for gates
+	float  value  = 0.f;  // velocity for notes, 1 / 0 for gates
+	transportTrack* track = nullptr;
+
+	bool isOff() const { return type == NoteOff || type == GateOff; }
+};
 
 class transportTrack {
 public:
@@ -93,8 +114,118 @@ protected:
 		}
 	}
 
+	// Calls fn(base, limit) for every clip pass overlapping [beatFrom, beatTo]:
+	// base is the global beat of local beat 0, limit is where the pass is cut
+	// (the next loop wrap or the clip end).
+	template<typename Fn>
+	void forEachClipPass(double beatFrom, double beatTo, Fn fn) const {
+		double dur = getClipDuration();
+		bool   lp  = getClipLoop() && dur > 0.001;
+		int nClips = getClipCount();
+		for(int ci = 0; ci < nClips; ci++) {
+			double cs = getClipStartAt(ci);
+			double ce = getClipEndAt(ci);
+			if(beatTo < cs || beatFrom > ce) continue;
+			if(!lp) { fn(cs, ce); continue; }
+			long k = std::max(0L, (long)std::ceil((beatFrom - cs) / dur) - 1);
+			for(; cs + k * dur <= beatTo && cs + k * dur < ce; k++)
+				fn(cs + k * dur, std::min(cs + (k + 1) * dur, ce));
+		}
+	}
+
+	// Block rendering helper: splits the samples beatFrom + i * step (i < numSamples)
+	// into runs that fall inside one clip pass and calls fn(i0, i1, base) for each,
+	// base being the global beat of the pass's local 0. Clips are visited last to
+	// first, so where clips overlap the earliest one is written last — matching the
+	// first-match clip lookup the tracks do in update().
+	template<typename Fn>
+	void forEachClipRun(double beatFrom, double step, int numSamples, Fn fn) const {
+		if(numSamples <= 0) return;
+		double beatTo = beatFrom + step * (numSamples - 1);
+		auto firstAtOrAfter = [&](double beat) {
+			if(step <= 0.0) return beat <= beatFrom ? 0 : numSamples;
+			int i = (int)ofClamp(std::ceil((beat - beatFrom) / step), 0.0, (double)numSamples);
+			while(i < numSamples && beatFrom + i * step < beat) i++;
+			while(i > 0 && beatFrom + (i - 1) * step >= beat) i--;
+			return i;
+		};
+		double dur = getClipDuration();
+		bool   lp  = getClipLoop() && dur > 0.001;
+		for(int ci = getClipCount() - 1; ci >= 0; ci--) {
+			double cs = getClipStartAt(ci);
+			double ce = getClipEndAt(ci);
+			if(beatTo < cs || beatFrom >= ce) continue;
+			if(!lp) {
+				int i0 = firstAtOrAfter(cs), i1 = firstAtOrAfter(ce);
+				if(i0 < i1) fn(i0, i1, cs);
+				continue;
+			}
+			long k = std::max(0L, (long)std::floor((beatFrom - cs) / dur));
+			for(; cs + k * dur <= beatTo && cs + k * dur < ce; k++) {
+				double base = cs + k * dur;
+				int i0 = firstAtOrAfter(base), i1 = firstAtOrAfter(std::min(base + dur, ce));
+				if(i0 < i1) fn(i0, i1, base);
+			}
+		}
+	}
+
+	// Piecewise-constant lane for block rendering: (beat, value) breakpoints sorted
+	// by beat, each value holding until the next one, 0 before the first. Where
+	// regions overlap the first one in `regions` wins, as in the tracks' update().
+	template<typename Region, typename GetValue>
+	static void buildStepLane(const std::vector<Region>& regions, GetValue getValue,
+	                          std::vector<std::pair<double, float>>& steps) {
+		std::vector<std::pair<double, int>> edges; // +(i+1) region starts, -(i+1) region ends
+		for(int i = 0; i < (int)regions.size(); i++) {
+			if(regions[i].end() <= regions[i].start) continue;
+			edges.push_back({regions[i].start, i + 1});
+			edges.push_back({regions[i].end(), -(i + 1)});
+		}
+		std::sort(edges.begin(), edges.end());
+		std::set<int> active;
+		steps.clear();
+		for(size_t e = 0; e < edges.size(); ) {
+			double beat = edges[e].first;
+			for(; e < edges.size() && edges[e].first == beat; e++) {
+				if(edges[e].second > 0) active.insert(edges[e].second - 1);
+				else active.erase(-edges[e].second - 1);
+			}
+			float v = active.empty() ? 0.f : getValue(regions[*active.begin()]);
+			if(steps.empty() || steps.back().second != v) steps.push_back({beat, v});
+		}
+	}
+
+	// Writes the step lane at x0 + i * step for i < count, walking the breakpoints forward
+	static void renderStepLane(const std::vector<std::pair<double, float>>& steps,
+	                           double x0, double step, int count, float* out) {
+		size_t j = std::upper_bound(steps.begin(), steps.end(), std::make_pair(x0, std::numeric_limits<float>::infinity())) - steps.begin();
+		for(int i = 0; i < count; i++) {
+			double x = x0 + i * step;
+			while(j < steps.size() && steps[j].first <= x) j++;
+			out[i] = j > 0 ? steps[j - 1].second : 0.f;
+		}
+	}
+
 public:
 
+	// Block rendering — writes one output channel (curve / lane) at numSamples
+	// beats beatFrom + i * (beatTo - beatFrom) / numSamples into out, with the
+	// values update() would output with the playhead at each of those beats.
+	// Tracks walk their segments across the block instead of looking every sample
+	// up, so high-rate senders can render from the timeline data without being
+	// tied to the frame rate. Call from the thread that edits the track.
+	virtual int  getRenderChannelCount() const { return 0; }
+	virtual bool renderBlock(int /*channel*/, double /*beatFrom*/, double /*beatTo*/,
+	                         int /*numSamples*/, float* /*out*/) { return false; }
+
+	// Lookahead scheduling — append every event whose global beat lies in
+	// [beatFrom, beatTo). The timeline never overlaps windows and splits them
+	// at loop / end-of-timeline wraps, so a window is always forward and contiguous.
+	virtual void collectEvents(double /*beatFrom*/, double /*beatTo*/, std::vector<transportEvent>& /*out*/) {}
+	// Called when the timeline drops its schedule (stop, jump, reset):
+	// append offs for anything the track left open.
+	virtual void flushEvents(double /*beat*/, std::vector<transportEvent>& /*out*/) {}
+
 	// Content stretching: call beginContentStretch() before drag, then
 	// applyContentStretch(factor) each frame with factor = newDur/originalDur.
 	virtual void   beginContentStretch()           {}
@@ -586,6 +586,23 @@ public:
 	}
 	
 
+	// Block rendering — one channel per lane
+	int getRenderChannelCount() const override { return numLanes.get(); }
+
+	bool renderBlock(int channel, double beatFrom, double beatTo, int numSamples, float* out) override {
+		if(channel < 0 || channel >= numLanes.get() || numSamples <= 0) return false;
+		std::fill(out, out + numSamples, 0.0f);
+		if(channel >= valueLanes.size()) return true;
+
+		double step = std::max(0.0, beatTo - beatFrom) / numSamples;
+		double cs0  = getClipStartAt(0); // regions are in primary clip space
+		buildStepLane(valueLanes[channel], [](const ValueRegion& r) { return r.value; }, renderSteps);
+		forEachClipRun(beatFrom, step, numSamples, [&](int i0, int i1, double base) {
+			renderStepLane(renderSteps, cs0 + (beatFrom - base) + i0 * step, step, i1 - i0, out + i0);
+		});
+		return true;
+	}
+
 	// Clip window virtuals
 	bool   hasClipWindow()        const override { return true; }
 	double getClipStart()         const override { return clipStart.get(); }
@@ -739,6 +756,7 @@ private:
 	std::vector<std::string> timelineOptions;
 	
 	std::vector<bool> lastActiveState;  // One per lane
+	std::vector<std::pair<double, float>> renderSteps;  // renderBlock scratch
 	ofEventListeners listeners;
 	
 	// Drag state for creating regions
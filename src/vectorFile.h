@@ -2,8 +2,8 @@
 #define VECTOR_FILE_H
 
 #include "ofxOceanodeNodeModel.h"
+#include "csvParser.h"
 #include <fstream>
-#include <sstream>
 #include <vector>
 #include <limits>
 
@@ -43,29 +43,13 @@ public:
 
     // Read file and update fileContent vector
     void readFile() {
-        std::ifstream file(currentFilePath);
-        if (!file.is_open()) {
+        csvParseReport report;
+        if (!csvParser::parseFile(currentFilePath, fileContent, report)) {
             ofLogError("Vector File") << "Failed to open file at " << currentFilePath;
             return;
         }
-
-        std::string textLine;
-        fileContent.clear();
-        while (std::getline(file, textLine)) {
-            std::istringstream iss(textLine);
-            std::string value;
-            std::vector<float> lineValues;
-            while (std::getline(iss, value, ',')) {
-                try {
-                    float val = std::stof(value);
-                    lineValues.push_back(val);
-                } catch (std::invalid_argument const &e) {
-                    ofLogWarning("Vector File") << "Failed to convert string to float: " << value;
-                } catch (std::out_of_range const &e) {
-                    ofLogWarning("Vector File") << "Float out of range: " << value;
-                }
-            }
-            fileContent.push_back(lineValues);
+        if (!report.ok()) {
+            ofLogWarning("Vector File") << currentFilePath << ": " << report.describe();
         }
 
         // Update line parameter max value
@@ -112,7 +96,7 @@ public:
     // Update the output parameter with values from the selected line
     void updateOutput(int lineNum) {
         if (lineNum >= 0 && lineNum < static_cast<int>(fileContent.size())) {
-            output.set(fileContent[lineNum]);
+            output.set(fileContent[lineNum].toVector());
         } else {
             output.set(vector<float>()); // Clear output if line number is invalid
         }
@@ -140,7 +124,7 @@ private:
     ofEventListener lineListener;
 
     std::string currentFilePath;
-    std::vector<std::vector<float>> fileContent;
+    csvTable fileContent;
 };
 
 #endif /* VECTOR_FILE_H */
@@ -6,6 +6,7 @@
 #define vectorTimer_h
 
 #include "ofxOceanodeNodeModel.h"
+#include "timerService.h"
 
 class vectorTimer : public ofxOceanodeNodeModel {
 public:
@@ -26,16 +27,22 @@ public:
             // Resize if necessary
             if (vf.size() != previousInput.size()) {
                 previousInput.resize(vf.size(), 0);
-                timerEnd.resize(vf.size(), 0);
+                timers.cancelFrom(vf.size());
                 vector<float> tempOutput = output.get();
                 tempOutput.resize(vf.size(), 0);
                 output = tempOutput;
             }
 
             // Check for changes
+            uint64_t now = timerService::nowMicros();
             for (int i = 0; i < vf.size(); ++i) {
                 if (vf[i] != previousInput[i]) {
-                    timerEnd[i] = ofGetElapsedTimeMillis() + ms.get()[i];
+                    const auto& durations = ms.get();
+                    float duration = i < durations.size() ? durations[i] : (durations.empty() ? 100 : durations.back());
+                    expired.erase(std::remove(expired.begin(), expired.end(), i), expired.end());
+                    timers.atTime(i, now + uint64_t(std::max(0.0f, duration) * 1000.0f), [this, i](uint64_t, uint64_t) {
+                        expired.push_back(i);
+                    });
                     vector<float> tempOutput = output.get();
                     tempOutput[i] = vf[i];
                     output = tempOutput;
@@ -48,19 +55,14 @@ public:
     }
 
     void update(ofEventArgs& args) {
-        auto currentTime = ofGetElapsedTimeMillis();
-        bool outputModified = false;
+        // Timers that fired this frame are applied together in one output
+        if (expired.empty()) return;
         vector<float> tempOutput = output.get();
-        for (int i = 0; i < timerEnd.size(); ++i) {
-            if (timerEnd[i] != 0 && currentTime >= timerEnd[i]) {
-                tempOutput[i] = 0;
-                timerEnd[i] = 0;
-                outputModified = true;
-            }
-        }
-        if (outputModified) {
-            output = tempOutput;
+        for (int i : expired) {
+            if (i < tempOutput.size()) tempOutput[i] = 0;
         }
+        expired.clear();
+        output = tempOutput;
     }
 
     void exit(ofEventArgs& args) {
@@ -75,7 +77,8 @@ private:
     vector<std::unique_ptr<ofEventListener>> listeners;
 
     vector<float> previousInput;
-    vector<unsigned long long> timerEnd;  // store end times in milliseconds
+    nodeTimers timers;    // pending reset to 0 per index
+    vector<int> expired;  // indices whose timer fired since the last update
 };
 
 #endif /* vectorTimer_h */
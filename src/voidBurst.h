@@ -1,7 +1,7 @@
 #pragma once
 
 #include "ofxOceanodeNodeModel.h"
-#include <deque>
+#include "timerService.h"
 
 class voidBurst : public ofxOceanodeNodeModel {
 public:
@@ -19,40 +19,40 @@ public:
         }));
     }
 
-    void update(ofEventArgs &) override {
-        const uint64_t currentFrame = ofGetFrameNum();
-
-        for(auto it = activeBursts.begin(); it != activeBursts.end();) {
-            if(currentFrame < it->nextTriggerFrame) {
-                ++it;
-                continue;
-            }
-
-            if(it->endPending) {
-                endOut.trigger();
-                it = activeBursts.erase(it);
-            } else {
-                voidOut.trigger();
-                it->remainingTriggers--;
-
-                if(it->remainingTriggers <= 0) {
-                    it->endPending = true;
-                }
-
-                it->nextTriggerFrame += static_cast<uint64_t>(it->frameGap + 1);
-                ++it;
-            }
-        }
-    }
-
 private:
     struct ScheduledBurst {
         int remainingTriggers;
         int frameGap;
-        uint64_t nextTriggerFrame;
         bool endPending;
     };
 
+    // Each active burst owns one frame timer, keyed by its slot in activeBursts
+    void armBurst(size_t slot, uint64_t frame) {
+        timers.atFrame(slot, frame, [this, slot](uint64_t scheduledFrame, uint64_t) {
+            fireBurst(slot, scheduledFrame);
+        });
+    }
+
+    // Indexes activeBursts afresh after each trigger: a patch feeding the
+    // output back into Trigger starts a new burst, which can grow the vector
+    void fireBurst(size_t slot, uint64_t scheduledFrame) {
+        if(activeBursts[slot].endPending) {
+            freeSlots.push_back(slot);
+            endOut.trigger();
+            return;
+        }
+
+        ScheduledBurst &burst = activeBursts[slot];
+        burst.remainingTriggers--;
+        if(burst.remainingTriggers <= 0) {
+            burst.endPending = true;
+        }
+
+        // Step from the scheduled frame, not the one the timer ran in
+        armBurst(slot, scheduledFrame + static_cast<uint64_t>(burst.frameGap + 1));
+        voidOut.trigger();
+    }
+
     void startBurst() {
         const int totalTriggers = numVoids.get();
         if(totalTriggers <= 0) return;
@@ -70,12 +70,15 @@ private:
             return;
         }
 
-        activeBursts.push_back({
-            totalTriggers - 1,
-            gap,
-            ofGetFrameNum() + static_cast<uint64_t>(gap + 1),
-            false
-        });
+        size_t slot = activeBursts.size();
+        if(!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            activeBursts.emplace_back();
+        }
+        activeBursts[slot] = {totalTriggers - 1, gap, false};
+        armBurst(slot, timerService::frameNum() + static_cast<uint64_t>(gap + 1));
     }
 
     ofParameter<void> triggerIn;
@@ -84,6 +87,8 @@ private:
     ofParameter<void> voidOut;
     ofParameter<void> endOut;
 
-    std::deque<ScheduledBurst> activeBursts;
+    vector<ScheduledBurst> activeBursts;
+    vector<size_t> freeSlots;  // finished entries of activeBursts
+    nodeTimers timers;
     ofEventListeners listeners;
 };